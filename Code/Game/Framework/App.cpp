@@ -118,6 +118,9 @@ void App::Startup()
 
     sWindowSubsystemConfig sWindowSubsystemConfig;
     sWindowSubsystemConfig.m_iconFilePath = L"C:/p4/Personal/SD/WindowKills/Run/Data/Images/windowIcon.ico";
+    sWindowSubsystemConfig.m_maxLiveWindows = 24;
+    sWindowSubsystemConfig.m_maxPresentsPerFrame = 12;
+    sWindowSubsystemConfig.m_idlePresentIntervalFrames = 4;
     g_theWindowSubsystem                 = new WindowSubsystem(sWindowSubsystemConfig);
 
     //-End-of-WindowSubsystem-------------------------------------------------------------------------
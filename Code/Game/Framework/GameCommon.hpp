@@ -4,6 +4,7 @@
 
 //----------------------------------------------------------------------------------------------------
 #pragma once
+#include <cstddef>
 #include <vector>
 
 //-Forward-Declaration--------------------------------------------------------------------------------
@@ -52,4 +53,19 @@ void GAME_SAFE_RELEASE(T*& pointer)
 }
 //-----------------------------------------------------------------------------------------------
 typedef uint32_t EntityID;
-typedef uint32_t WindowID;
\ No newline at end of file
+typedef uint32_t WindowID;
+
+//----------------------------------------------------------------------------------------------------
+// Non-owning read-only view over contiguous elements. Valid until the owner next changes its storage.
+template <typename T>
+struct sConstSpan
+{
+    T const* m_data = nullptr;
+    size_t   m_size = 0;
+
+    T const* begin() const { return m_data; }
+    T const* end() const { return m_data + m_size; }
+    size_t   size() const { return m_size; }
+    bool     empty() const { return m_size == 0; }
+    T const& operator[](size_t const index) const { return m_data[index]; }
+};
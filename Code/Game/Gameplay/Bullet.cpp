@@ -29,7 +29,8 @@ Bullet::Bullet(EntityID const& entityID,
 
     if (m_hasChildWindow)
     {
-        g_theWindowSubsystem->CreateChildWindow(m_entityID, m_name, static_cast<int>(m_position.x), static_cast<int>(m_position.y), 100, 100);
+        WindowID const windowID = g_theWindowSubsystem->CreateChildWindow(m_entityID, m_name, static_cast<int>(m_position.x), static_cast<int>(m_position.y), 100, 100);
+        g_theWindowSubsystem->BindWindow(windowID, m_windowBinding);
     }
 }
 
@@ -49,54 +50,43 @@ void Bullet::Update(float const deltaSeconds)
     m_position.x += m_velocity.x * deltaSeconds * m_speed;
     m_position.y += m_velocity.y * deltaSeconds * m_speed;
 
-    WindowID windowID = g_theWindowSubsystem->FindWindowIDByEntityID(g_theGame->GetPlayer()->m_entityID);
-    Window*  window   = g_theWindowSubsystem->GetWindow(windowID);
+    WindowID               windowID = g_theGame->GetPlayer()->m_windowBinding.m_windowID;
+    sWindowGeometry const* geometry = g_theGame->GetPlayer()->GetWindowGeometry();
 
-    // 檢查碰撞，但只在不在動畫中時才觸發新的動畫
-    // if (!g_theWindowSubsystem->IsWindowAnimating(windowID))
+    // 檢查碰撞：同一幀多顆子彈撞邊會合併成一個目標，動畫中也只會改目標而不重新開始
     {
-        Vec2 currentPos  = window->GetWindowPosition();
-        Vec2 currentSize = window->GetWindowDimensions();
+        Vec2 currentPos  = geometry->GetWindowPosition();
+        Vec2 currentSize = geometry->GetWindowDimensions();
 
         if (m_position.x + m_physicRadius * 2.f > currentPos.x + currentSize.x)
         {
             // 右邊界：增加寬度
-            Vec2 newPos  = currentPos + Vec2(10, 0);
-            Vec2 newSize = currentSize + Vec2(10, 0);
-            g_theWindowSubsystem->AnimateWindowPositionAndDimensions(windowID, newPos, newSize, 0.1f);
+            g_theWindowSubsystem->RequestWindowRectDelta(windowID, Vec2(10, 0), Vec2(10, 0), 0.1f);
             m_health -= 1;
         }
         else if (m_position.x - m_physicRadius * 2.f < currentPos.x)
         {
             // 左邊界：向左移動並增加寬度
-            Vec2 newPos  = currentPos + Vec2(-20, 0);
-            Vec2 newSize = currentSize + Vec2(10, 0);
-            g_theWindowSubsystem->AnimateWindowPositionAndDimensions(windowID, newPos, newSize, 0.1f);
+            g_theWindowSubsystem->RequestWindowRectDelta(windowID, Vec2(-20, 0), Vec2(10, 0), 0.1f);
             m_health -= 1;
         }
         else if (m_position.y + m_physicRadius * 2.f > currentPos.y + currentSize.y)
         {
             // 上邊界：向上移動並增加高度
-            Vec2 newPos  = currentPos + Vec2(0, 10);
-            Vec2 newSize = currentSize + Vec2(0, 10);
-            g_theWindowSubsystem->AnimateWindowPositionAndDimensions(windowID, newPos, newSize, 0.1f);
+            g_theWindowSubsystem->RequestWindowRectDelta(windowID, Vec2(0, 10), Vec2(0, 10), 0.1f);
             m_health -= 1;
         }
         else if (m_position.y - m_physicRadius * 2.f < currentPos.y)
         {
             // 下邊界：增加高度
-            Vec2 newPos  = currentPos + Vec2(0, -20);
-            Vec2 newSize = currentSize + Vec2(0, 10);
-            g_theWindowSubsystem->AnimateWindowPositionAndDimensions(windowID, newPos, newSize, 0.1f);
+            g_theWindowSubsystem->RequestWindowRectDelta(windowID, Vec2(0, -20), Vec2(0, 10), 0.1f);
             m_health -= 1;
         }
     }
 
     if (m_hasChildWindow)
     {
-        WindowID    windowID2   = g_theWindowSubsystem->FindWindowIDByEntityID(m_entityID);
-        WindowData* windowData2 = g_theWindowSubsystem->GetWindowData(windowID2);
-        windowData2->m_window->SetClientPosition(m_position - windowData2->m_window->GetClientDimensions() * 0.5f);
+        g_theWindowSubsystem->RequestClientPosition(m_windowBinding.m_windowID, m_position - GetWindowGeometry()->GetClientDimensions() * 0.5f, m_velocity * m_speed);
     }
 }
 
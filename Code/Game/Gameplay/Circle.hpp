@@ -5,7 +5,7 @@
 //----------------------------------------------------------------------------------------------------
 #pragma once
 
-#include "Game/Subsystem/Window/WindowSubsystem.hpp"
+#include "Game/Gameplay/Entity.hpp"
 
 //----------------------------------------------------------------------------------------------------
 class Circle : public Entity
@@ -30,7 +30,8 @@ Coin::Coin(EntityID const entityID,
 
     if (m_hasChildWindow)
     {
-        g_theWindowSubsystem->CreateChildWindow(m_entityID, m_name, static_cast<int>(m_position.x), static_cast<int>(m_position.y), 200, 200);
+        WindowID const windowID = g_theWindowSubsystem->CreateChildWindow(m_entityID, m_name, static_cast<int>(m_position.x), static_cast<int>(m_position.y), 200, 200);
+        g_theWindowSubsystem->BindWindow(windowID, m_windowBinding);
     }
 }
 
@@ -50,9 +51,7 @@ void Coin::Update(float const deltaSeconds)
     Entity::Update(deltaSeconds);
     if (m_hasChildWindow)
     {
-        WindowID    windowID   = g_theWindowSubsystem->FindWindowIDByEntityID(m_entityID);
-        WindowData* windowData = g_theWindowSubsystem->GetWindowData(windowID);
-        windowData->m_window->SetClientPosition(m_position - windowData->m_window->GetClientDimensions() * 0.5f);
+        g_theWindowSubsystem->RequestClientPosition(m_windowBinding.m_windowID, m_position - GetWindowGeometry()->GetClientDimensions() * 0.5f, m_velocity * m_speed);
     }
 }
 
@@ -6,7 +6,7 @@
 #pragma once
 
 #include "Engine/Core/EventSystem.hpp"
-#include "Game/Subsystem/Window/WindowSubsystem.hpp"
+#include "Game/Gameplay/Entity.hpp"
 
 //----------------------------------------------------------------------------------------------------
 class Coin : public Entity
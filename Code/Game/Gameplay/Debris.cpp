@@ -22,7 +22,8 @@ Debris::Debris(EntityID const entityID,
     m_thickness      = 10.f;
     m_cosmeticRadius = m_physicRadius + m_thickness;
 
-    g_theWindowSubsystem->CreateChildWindow(m_entityID, m_name, static_cast<int>(m_position.x), static_cast<int>(m_position.y), 200, 200);
+    WindowID const windowID = g_theWindowSubsystem->CreateChildWindow(m_entityID, m_name, static_cast<int>(m_position.x), static_cast<int>(m_position.y), 200, 200);
+    g_theWindowSubsystem->BindWindow(windowID, m_windowBinding);
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -37,9 +38,7 @@ void Debris::Update(float const deltaSeconds)
     Entity::Update(deltaSeconds);
     // m_velocity = Vec2::MakeFromPolarDegrees(m_orientationDegrees);
     // m_position += m_velocity * deltaSeconds * m_speed;
-    WindowID    windowID   = g_theWindowSubsystem->FindWindowIDByEntityID(m_entityID);
-    WindowData* windowData = g_theWindowSubsystem->GetWindowData(windowID);
-    windowData->m_window->SetClientPosition(m_position - windowData->m_window->GetClientDimensions() * 0.5f);
+    g_theWindowSubsystem->RequestClientPosition(m_windowBinding.m_windowID, m_position - GetWindowGeometry()->GetClientDimensions() * 0.5f);
 }
 
 //----------------------------------------------------------------------------------------------------
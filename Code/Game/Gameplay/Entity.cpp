@@ -24,13 +24,19 @@ Entity::Entity(Vec2 const&  position,
 
 Entity::~Entity()
 {
+    g_theWindowSubsystem->UnbindWindow(m_windowBinding);
 }
 
 void Entity::Update(float const deltaSeconds)
 {
     UNUSED(deltaSeconds)
     if (m_health <= 0) MarkAsDead();
-    m_isChildWindowVisible ? g_theWindowSubsystem->ShowWindowByWindowID(g_theWindowSubsystem->FindWindowIDByEntityID(m_entityID)) : g_theWindowSubsystem->HideWindowByWindowID(g_theWindowSubsystem->FindWindowIDByEntityID(m_entityID));
+    if (m_windowBinding.IsBound()) g_theWindowSubsystem->RequestWindowVisibility(m_windowBinding.m_windowID, m_isChildWindowVisible);
+}
+
+sWindowGeometry const* Entity::GetWindowGeometry() const
+{
+    return g_theWindowSubsystem->GetWindowGeometry(m_windowBinding.m_windowID);
 }
 
 void Entity::MarkAsDead()
@@ -15,7 +15,6 @@ public:
     explicit Entity(Vec2 const& position, float orientationDegrees, Rgba8 const& color, bool isVisible, bool hasChildWindow);
     virtual  ~Entity();
     EntityID m_entityID           = 0;
-    WindowID m_windowID           = 0;
     String   m_name               = "DEFAULT";
     Vec2     m_position           = Vec2::ZERO;
     Vec2     m_velocity           = Vec2::ZERO;
@@ -27,6 +26,8 @@ public:
     float    m_cosmeticRadius     = 0.f;
     float    m_thickness          = 0.f;
 
+    sWindowBinding m_windowBinding;     // Cached child window, invalidated by WindowSubsystem when the window is destroyed
+
     virtual void Update(float deltaSeconds);
     virtual void Render() const = 0;
     virtual void UpdateFromInput(float deltaSeconds) = 0;    // TODO: should entity handle its own input logic? or should the game handle it for him?
@@ -43,6 +44,8 @@ public:
     virtual bool IsChildWindowVisible() const;
     virtual bool IsEntityVisible() const;
 
+    sWindowGeometry const* GetWindowGeometry() const;     // This frame's child window geometry, nullptr without a window
+
     void  IncreaseHealth(int amount);
     void  DecreaseHealth(int amount);
     float m_speed = 100.f;
@@ -91,8 +91,17 @@ void Game::Update()
         {
             if (!entity->IsDead())  // 再檢查是否存活
             {
+                Vec2 const previousPosition = entity->m_position;
+
                 entity->Update(gameDeltaSeconds);
                 entity->UpdateFromInput(gameDeltaSeconds);
+
+                // 實體移動過的地方，底下子視窗的畫面也變了，需要優先 present
+                if (entity->m_position != previousPosition)
+                {
+                    g_theWindowSubsystem->MarkWindowContentChangedInDisc(previousPosition, entity->m_cosmeticRadius);
+                    g_theWindowSubsystem->MarkWindowContentChangedInDisc(entity->m_position, entity->m_cosmeticRadius);
+                }
             }
             else
             {
@@ -138,6 +147,8 @@ STATIC bool Game::OnGameStateChanged(EventArgs& args)
 
     if (preGameState == "ATTRACT" && curGameState == "GAME")
     {
+        // Pre-create one wave worth of Triangle windows so spawning doesn't hitch on CreateWindowEx / SwapChain
+        g_theWindowSubsystem->WarmUpWindowPool(200, 200, 3);
         g_theGame->SpawnEntity();
         g_theAudio->StopSound(g_theGame->m_attractPlaybackID);
         SoundID const ingameBGM       = g_theAudio->CreateOrGetSound("Data/Audio/ingame.mp3", eAudioSystemSoundDimension::Sound2D);
@@ -11,7 +11,7 @@
 #include "Engine/Renderer/DebugRenderSystem.hpp"
 #include "Game/Gameplay/Bullet.hpp"
 #include "Game/Gameplay/Game.hpp"
-#include "Game/Subsystem/Widget/ButtonWidget.hpp"
+#include "Game/Subsystem/Widget/NumericTextWidget.hpp"
 #include "Game/Subsystem/Widget/WidgetSubsystem.hpp"
 
 //----------------------------------------------------------------------------------------------------
@@ -36,18 +36,25 @@ Player::Player(EntityID const entityID,
     g_theEventSystem->SubscribeEventCallbackFunction("OnGameStateChanged", OnGameStateChanged);
     g_theEventSystem->SubscribeEventCallbackFunction("OnCollisionEnter", OnCollisionEnter);
 
-    g_theWindowSubsystem->CreateChildWindow(m_entityID, m_name, 100, 100, (int)(1445 * 0.6f), (int)(248));
+    WindowID const windowID = g_theWindowSubsystem->CreateChildWindow(m_entityID, m_name, 100, 100, (int)(1445 * 0.6f), (int)(248));
+    g_theWindowSubsystem->BindWindow(windowID, m_windowBinding);
+    g_theWindowSubsystem->SetWindowPinned(windowID, true);
 
-    Window* window                = g_theWindowSubsystem->GetWindow(g_theWindowSubsystem->FindWindowIDByEntityID(m_entityID));
-    Vec2    windowClientPosition  = window->GetClientPosition();
-    Vec2    windowClientDimension = window->GetClientDimensions();
-
-    m_coinWidget   = g_theWidgetSubsystem->CreateWidget<ButtonWidget>(g_theWidgetSubsystem, Stringf("Coin=%d", m_coin), (int)windowClientPosition.x, (int)windowClientPosition.y, (int)windowClientDimension.x, (int)windowClientDimension.y, m_color);
-    m_healthWidget = g_theWidgetSubsystem->CreateWidget<ButtonWidget>(g_theWidgetSubsystem, Stringf("Health=%d/%d", m_health, m_maxHealth), (int)windowClientPosition.x, (int)windowClientPosition.y, (int)windowClientDimension.x, (int)windowClientDimension.y, m_color);
+    sWindowGeometry const* geometry              = GetWindowGeometry();
+    Vec2                   windowClientPosition  = geometry->GetClientPosition();
+    Vec2                   windowClientDimension = geometry->GetClientDimensions();
 
+    // 文字直接綁定數值，數值改變時 Widget 自己重新格式化，不需要每次 SetText(Stringf(...))
+    m_coinWidget   = g_theWidgetSubsystem->CreateWidget<NumericTextWidget>("Coin=%d", (int)windowClientPosition.x, (int)windowClientPosition.y, (int)windowClientDimension.x, (int)windowClientDimension.y, m_color);
+    m_healthWidget = g_theWidgetSubsystem->CreateWidget<NumericTextWidget>("Health=%d/%d", (int)windowClientPosition.x, (int)windowClientPosition.y, (int)windowClientDimension.x, (int)windowClientDimension.y, m_color);
+    m_coinWidget->BindValue(&m_coin);
+    m_healthWidget->BindValue(&m_health);
+    m_healthWidget->BindValue(&m_maxHealth);
 
     g_theWidgetSubsystem->AddWidget(m_coinWidget, 100);
     g_theWidgetSubsystem->AddWidget(m_healthWidget, 200);
+    g_theWidgetSubsystem->SetWidgetAnchor(m_coinWidget, sWidgetAnchor::MakeWindowAnchor(windowID));
+    g_theWidgetSubsystem->SetWidgetAnchor(m_healthWidget, sWidgetAnchor::MakeWindowAnchor(windowID, Vec2(0, 20)));
 
     m_coinWidget->SetVisible(false);
     m_healthWidget->SetVisible(false);
@@ -56,7 +63,6 @@ Player::Player(EntityID const entityID,
 //----------------------------------------------------------------------------------------------------
 Player::~Player()
 {
-    Entity::~Entity();
     g_theWindowSubsystem->RemoveEntityFromMappings(m_entityID);
     g_theEventSystem->UnsubscribeEventCallbackFunction("OnGameStateChanged", OnGameStateChanged);
     g_theEventSystem->UnsubscribeEventCallbackFunction("OnCollisionEnter", OnCollisionEnter);
@@ -76,12 +82,14 @@ void Player::Update(float const deltaSeconds)
     {
         UpdateFromInput(deltaSeconds);
         BounceOfWindow();
-        ShrinkWindow();
+        ShrinkWindow(deltaSeconds);
     }
 
-    WindowID    windowID   = g_theWindowSubsystem->FindWindowIDByEntityID(m_entityID);
-    WindowData* windowData = g_theWindowSubsystem->GetWindowData(windowID);
-    if (windowData == nullptr) return;
+    // 視窗預算以玩家為中心，離玩家越遠的視窗越先變成虛擬視窗
+    g_theWindowSubsystem->SetWindowBudgetFocus(m_position);
+
+    sWindowGeometry const* geometry = GetWindowGeometry();
+    if (geometry == nullptr) return;
     // WindowRect  rect       = windowData->m_window->lastRect;
     // DebugAddScreenText(Stringf("Player Window Position(top:%ld, bottom:%ld, left:%ld, right:%ld)", rect.top, rect.bottom, rect.left, rect.right), Vec2(0.f, Window::s_mainWindow->GetScreenDimensions().y - 20.f), 20.f, Vec2::ZERO, 0.f);
     // DebugAddScreenText(Stringf("Player Window Dimensions(width:%.1f, height:%.1f)", windowData->m_window->GetWindowDimensions().x, windowData->m_window->GetWindowDimensions().y), Vec2(0.f, Window::s_mainWindow->GetScreenDimensions().y - 40.f), 20.f, Vec2::ZERO, 0.f);
@@ -90,15 +98,10 @@ void Player::Update(float const deltaSeconds)
     // DebugAddScreenText(Stringf("Player Client Position(width:%.1f, height:%.1f)", windowData->m_window->GetClientPosition().x, windowData->m_window->GetClientPosition().y), Vec2(0.f, Window::s_mainWindow->GetScreenDimensions().y - 100.f), 20.f, Vec2::ZERO, 0.f);
     // DebugAddScreenText(Stringf("Player Position(%.1f, %.1f)", m_position.x, m_position.y), Vec2(0.f, Window::s_mainWindow->GetScreenDimensions().y - 120.f), 20.f, Vec2::ZERO, 0.f);
 
-    m_coinWidget->SetPosition(windowData->m_window->GetClientPosition());
-    m_coinWidget->SetDimensions(windowData->m_window->GetClientDimensions());
-    m_healthWidget->SetPosition(windowData->m_window->GetClientPosition() + Vec2(0, 20));
-    m_healthWidget->SetDimensions(windowData->m_window->GetClientDimensions());
-
 
     if (g_theGame->GetCurrentGameState() == eGameState::ATTRACT)
     {
-        windowData->m_window->SetClientPosition(m_position - windowData->m_window->GetClientDimensions() * 0.5f);
+        g_theWindowSubsystem->RequestClientPosition(m_windowBinding.m_windowID, m_position - geometry->GetClientDimensions() * 0.5f);
     }
 }
 
@@ -158,12 +161,11 @@ void Player::UpdateFromInput(float const deltaSeconds)
 //----------------------------------------------------------------------------------------------------
 void Player::UpdateWindowFocus()
 {
-    WindowID    windowID   = g_theWindowSubsystem->FindWindowIDByEntityID(m_entityID);
-    WindowData* windowData = g_theWindowSubsystem->GetWindowData(windowID);
+    Window* window = m_windowBinding.m_window;
 
-    if (windowData && windowData->m_window && windowData->m_window->GetWindowHandle())
+    if (window && window->GetWindowHandle())
     {
-        HWND hwnd = (HWND)windowData->m_window->GetWindowHandle();
+        HWND hwnd = (HWND)window->GetWindowHandle();
 
         // 只有在視窗失去焦點時才重新設定
         if (GetForegroundWindow() != hwnd)
@@ -190,16 +192,15 @@ void Player::FireBullet()
 
 void Player::BounceOfWindow()
 {
-    WindowID    windowID   = g_theWindowSubsystem->FindWindowIDByEntityID(m_entityID);
-    WindowData* windowData = g_theWindowSubsystem->GetWindowData(windowID);
+    sWindowGeometry const* geometry = GetWindowGeometry();
 
-    if (windowData == nullptr) return;
+    if (geometry == nullptr) return;
 
     // 取得視窗的邊界
-    float windowLeft   = windowData->m_window->GetClientPosition().x;
-    float windowBottom = windowData->m_window->GetClientPosition().y;
-    float windowTop    = windowData->m_window->GetClientPosition().y + windowData->m_window->GetClientDimensions().y;
-    float windowRight  = windowData->m_window->GetClientPosition().x + windowData->m_window->GetClientDimensions().x;
+    float windowLeft   = geometry->m_clientRect.m_mins.x;
+    float windowBottom = geometry->m_clientRect.m_mins.y;
+    float windowTop    = geometry->m_clientRect.m_maxs.y;
+    float windowRight  = geometry->m_clientRect.m_maxs.x;
 
 
     float clampedX = GetClamped(m_position.x,
@@ -215,23 +216,18 @@ void Player::BounceOfWindow()
     m_position.y = clampedY;
 }
 
-void Player::ShrinkWindow()
+void Player::ShrinkWindow(float const deltaSeconds)
 {
-    WindowID windowID = g_theWindowSubsystem->FindWindowIDByEntityID(m_entityID);
-    Window*  window   = g_theWindowSubsystem->GetWindow(windowID);
+    WindowID               windowID = m_windowBinding.m_windowID;
+    sWindowGeometry const* geometry = GetWindowGeometry();
+    if (geometry == nullptr) return;
 
-    if (!g_theWindowSubsystem->IsWindowAnimating(windowID))
-    {
-        Vec2 currentPos              = window->GetWindowPosition();
-        Vec2 currentSize             = window->GetWindowDimensions();
-        Vec2 currentClientDimensions = window->GetClientDimensions();
-        if (currentClientDimensions.x <= m_physicRadius * 2.5f || currentClientDimensions.y <= m_physicRadius * 2.5f) return;
-
-        // 右邊界：增加寬度
-        Vec2 newPos  = currentPos + Vec2(1, 1);
-        Vec2 newSize = currentSize + Vec2(-1, -1);
-        g_theWindowSubsystem->AnimateWindowPositionAndDimensions(windowID, newPos, newSize, 0.1f);
-    }
+    Vec2 currentClientDimensions = geometry->GetClientDimensions();
+    if (currentClientDimensions.x <= m_physicRadius * 2.5f || currentClientDimensions.y <= m_physicRadius * 2.5f) return;
+
+    // 每 0.1 秒縮 1 像素；連續請求會併入正在進行的動畫，而不是等動畫結束再重新開始
+    float const shrinkPixels = deltaSeconds * 10.f;
+    g_theWindowSubsystem->RequestWindowRectDelta(windowID, Vec2(shrinkPixels, shrinkPixels), Vec2(-shrinkPixels, -shrinkPixels), 0.1f);
 }
 
 bool Player::OnGameStateChanged(EventArgs& args)
@@ -247,9 +243,8 @@ bool Player::OnGameStateChanged(EventArgs& args)
     {
         g_theGame->GetPlayer()->m_coinWidget->SetVisible(false);
         g_theGame->GetPlayer()->m_healthWidget->SetVisible(false);
-        WindowID windowID = g_theWindowSubsystem->FindWindowIDByEntityID(g_theGame->GetPlayer()->m_entityID);
-        Window*  window   = g_theWindowSubsystem->GetWindow(windowID);
-        window->SetClientDimensions(Vec2((int)(1445 * 0.6f), (int)(248)));
+        WindowID windowID = g_theGame->GetPlayer()->m_windowBinding.m_windowID;
+        g_theWindowSubsystem->RequestClientDimensions(windowID, Vec2((int)(1445 * 0.6f), (int)(248)));
     }
 
     return false;
@@ -265,12 +260,10 @@ STATIC bool Player::OnCollisionEnter(EventArgs& args)
     if (entityA == "You" && entityB == "Coin")
     {
         player->IncreaseCoin(1);
-        player->m_coinWidget->SetText(Stringf("Coin=%d", player->m_coin));
     }
     else if (entityA == "You" && entityB == "Triangle")
     {
         player->DecreaseHealth(1);
-        player->m_healthWidget->SetText(Stringf("Health=%d/%d", player->m_health, player->m_maxHealth));
         player->m_position += (player->m_position - entity->m_position);
     }
 
@@ -10,7 +10,7 @@
 #include "Game/Gameplay/Entity.hpp"
 
 //-Forward-Declaration--------------------------------------------------------------------------------
-class ButtonWidget;
+class NumericTextWidget;
 
 //----------------------------------------------------------------------------------------------------
 class Player : public Entity
@@ -25,8 +25,8 @@ public:
     void                          UpdateFromInput(float deltaSeconds) override;
     void                          UpdateWindowFocus();
     void                          FireBullet();
-    std::shared_ptr<ButtonWidget> m_healthWidget;
-    std::shared_ptr<ButtonWidget> m_coinWidget;
+    NumericTextWidget*            m_healthWidget = nullptr;     // Owned by g_theWidgetSubsystem, released with MarkForDestroy
+    NumericTextWidget*            m_coinWidget   = nullptr;     // Both read m_health / m_maxHealth / m_coin directly
     int                           m_maxHealth = 0;
     int                           m_coin      = 50;
 
@@ -36,7 +36,7 @@ private:
     void        IncreaseCoin(int amount);
     void        DecreaseCoin(int amount);
     void        BounceOfWindow();
-    void        ShrinkWindow();
+    void        ShrinkWindow(float deltaSeconds);
 
     Timer m_bulletFireTimer;
 };
\ No newline at end of file
@@ -32,18 +32,24 @@ Shop::Shop(EntityID const entityID,
 
     if (m_hasChildWindow)
     {
-        g_theWindowSubsystem->CreateChildWindow(m_entityID, m_name, static_cast<int>(m_position.x), static_cast<int>(m_position.y), 700, 500);
-
-        Window* window                = g_theWindowSubsystem->GetWindow(g_theWindowSubsystem->FindWindowIDByEntityID(m_entityID));
-        Vec2    windowClientPosition  = window->GetClientPosition();
-        Vec2    windowClientDimension = window->GetClientDimensions();
-
-        m_itemWidgetA = g_theWidgetSubsystem->CreateWidget<ButtonWidget>(g_theWidgetSubsystem, Stringf("A=%d", m_health), (int)windowClientPosition.x, (int)windowClientPosition.y, (int)windowClientDimension.x, (int)windowClientDimension.y, m_color);
-        m_itemWidgetB = g_theWidgetSubsystem->CreateWidget<ButtonWidget>(g_theWidgetSubsystem, Stringf("B=%d", m_health), (int)windowClientPosition.x, (int)windowClientPosition.y, (int)windowClientDimension.x, (int)windowClientDimension.y, m_color);
-        m_itemWidgetC = g_theWidgetSubsystem->CreateWidget<ButtonWidget>(g_theWidgetSubsystem, Stringf("C=%d", m_health), (int)windowClientPosition.x, (int)windowClientPosition.y, (int)windowClientDimension.x, (int)windowClientDimension.y, m_color);
+        WindowID const windowID = g_theWindowSubsystem->CreateChildWindow(m_entityID, m_name, static_cast<int>(m_position.x), static_cast<int>(m_position.y), 700, 500);
+        g_theWindowSubsystem->BindWindow(windowID, m_windowBinding);
+        g_theWindowSubsystem->SetWindowPinned(windowID, true);
+
+        sWindowGeometry const* geometry              = GetWindowGeometry();
+        Vec2                   windowClientPosition  = geometry->GetClientPosition();
+        Vec2                   windowClientDimension = geometry->GetClientDimensions();
+
+        // 商品名稱是固定的，建立時設定一次就好
+        m_itemWidgetA = g_theWidgetSubsystem->CreateWidget<ButtonWidget>(g_theWidgetSubsystem, "speed", (int)windowClientPosition.x, (int)windowClientPosition.y, (int)windowClientDimension.x, (int)windowClientDimension.y, m_color);
+        m_itemWidgetB = g_theWidgetSubsystem->CreateWidget<ButtonWidget>(g_theWidgetSubsystem, "health", (int)windowClientPosition.x, (int)windowClientPosition.y, (int)windowClientDimension.x, (int)windowClientDimension.y, m_color);
+        m_itemWidgetC = g_theWidgetSubsystem->CreateWidget<ButtonWidget>(g_theWidgetSubsystem, "max   \nhealth", (int)windowClientPosition.x, (int)windowClientPosition.y, (int)windowClientDimension.x, (int)windowClientDimension.y, m_color);
         g_theWidgetSubsystem->AddWidget(m_itemWidgetA, 999);
         g_theWidgetSubsystem->AddWidget(m_itemWidgetB, 999);
         g_theWidgetSubsystem->AddWidget(m_itemWidgetC, 999);
+        g_theWidgetSubsystem->SetWidgetAnchor(m_itemWidgetA, sWidgetAnchor::MakeWindowAnchor(windowID, Vec2(-500, 200)));
+        g_theWidgetSubsystem->SetWidgetAnchor(m_itemWidgetB, sWidgetAnchor::MakeWindowAnchor(windowID, Vec2(-300, 200)));
+        g_theWidgetSubsystem->SetWidgetAnchor(m_itemWidgetC, sWidgetAnchor::MakeWindowAnchor(windowID, Vec2(-100, 200)));
         m_itemWidgetA->SetVisible(false);
         m_itemWidgetB->SetVisible(false);
         m_itemWidgetC->SetVisible(false);
@@ -78,20 +84,11 @@ void Shop::Update(float const deltaSeconds)
 {
     Entity::Update(deltaSeconds);
 
+    sWindowGeometry const* geometry = GetWindowGeometry();
     if (m_hasChildWindow)
     {
-        WindowID    windowID   = g_theWindowSubsystem->FindWindowIDByEntityID(m_entityID);
-        WindowData* windowData = g_theWindowSubsystem->GetWindowData(windowID);
-        windowData->m_window->SetClientPosition(m_position - windowData->m_window->GetClientDimensions() * 0.5f);
+        g_theWindowSubsystem->RequestClientPosition(m_windowBinding.m_windowID, m_position - geometry->GetClientDimensions() * 0.5f);
     }
-    WindowID    windowID   = g_theWindowSubsystem->FindWindowIDByEntityID(m_entityID);
-    WindowData* windowData = g_theWindowSubsystem->GetWindowData(windowID);
-    m_itemWidgetA->SetPosition(windowData->m_window->GetClientPosition() - Vec2(500, -200));
-    m_itemWidgetB->SetPosition(windowData->m_window->GetClientPosition() - Vec2(300, -200));
-    m_itemWidgetC->SetPosition(windowData->m_window->GetClientPosition() - Vec2(100, -200));
-    m_itemWidgetA->SetDimensions(windowData->m_window->GetClientDimensions());
-    m_itemWidgetB->SetDimensions(windowData->m_window->GetClientDimensions());
-    m_itemWidgetC->SetDimensions(windowData->m_window->GetClientDimensions());
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -112,11 +109,6 @@ void Shop::Render() const
     g_theRenderer->BindTexture(nullptr);
     g_theRenderer->BindShader(g_theRenderer->CreateOrGetShaderFromFile("Data/Shaders/Default"));
     g_theRenderer->DrawVertexArray(verts);
-
-
-    m_itemWidgetA->SetText(Stringf("speed"));
-    m_itemWidgetB->SetText(Stringf("health"));
-    m_itemWidgetC->SetText(Stringf("max   \nhealth"));
 }
 
 STATIC bool Shop::OnGameStateChanged(EventArgs& args)
@@ -161,15 +153,11 @@ void Shop::UpdateFromInput(float const deltaSeconds)
     else if (g_theInput->WasKeyJustPressed(NUMCODE_2))
     {
         player->m_health += 5;
-        player->m_healthWidget->SetText(Stringf("Health=%d/%d", player->m_health, player->m_maxHealth));
         player->m_coin -= 5;
-        player->m_coinWidget->SetText(Stringf("Coin=%d", player->m_coin));
     }
     else if (g_theInput->WasKeyJustPressed(NUMCODE_3))
     {
         player->m_maxHealth += 5;
-        player->m_healthWidget->SetText(Stringf("Health=%d/%d", player->m_health, player->m_maxHealth));
         player->m_coin -= 10;
-        player->m_coinWidget->SetText(Stringf("Coin=%d", player->m_coin));
     }
 }
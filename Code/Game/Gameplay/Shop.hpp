@@ -6,7 +6,7 @@
 #pragma once
 
 #include "Engine/Core/EventSystem.hpp"
-#include "Game/Subsystem/Window/WindowSubsystem.hpp"
+#include "Game/Gameplay/Entity.hpp"
 
 //-Forward-Declaration--------------------------------------------------------------------------------
 class ButtonWidget;
@@ -37,8 +37,8 @@ private:
     static bool OnGameStateChanged(EventArgs& args);
     void        UpdateFromInput(float deltaSeconds) override;
 
-    std::shared_ptr<ButtonWidget> m_itemWidgetA;
-    std::shared_ptr<ButtonWidget> m_itemWidgetB;
-    std::shared_ptr<ButtonWidget> m_itemWidgetC;
+    ButtonWidget*                 m_itemWidgetA = nullptr;      // Owned by g_theWidgetSubsystem, released with MarkForDestroy
+    ButtonWidget*                 m_itemWidgetB = nullptr;
+    ButtonWidget*                 m_itemWidgetC = nullptr;
     std::vector<Item>             m_itemList;
 };
@@ -9,7 +9,7 @@
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Math/RandomNumberGenerator.hpp"
 #include "Game/Gameplay/Game.hpp"
-#include "Game/Subsystem/Widget/ButtonWidget.hpp"
+#include "Game/Subsystem/Widget/NumericTextWidget.hpp"
 #include "Game/Subsystem/Widget/WidgetSubsystem.hpp"
 
 //----------------------------------------------------------------------------------------------------
@@ -32,14 +32,17 @@ Triangle::Triangle(EntityID const entityID,
 
     if (m_hasChildWindow)
     {
-        g_theWindowSubsystem->CreateChildWindow(m_entityID, m_name, static_cast<int>(m_position.x), static_cast<int>(m_position.y), 200, 200);
+        WindowID const windowID = g_theWindowSubsystem->CreateChildWindow(m_entityID, m_name, static_cast<int>(m_position.x), static_cast<int>(m_position.y), 200, 200);
+        g_theWindowSubsystem->BindWindow(windowID, m_windowBinding);
 
-        Window* window                = g_theWindowSubsystem->GetWindow(g_theWindowSubsystem->FindWindowIDByEntityID(m_entityID));
-        Vec2    windowClientPosition  = window->GetClientPosition();
-        Vec2    windowClientDimension = window->GetClientDimensions();
+        sWindowGeometry const* geometry              = GetWindowGeometry();
+        Vec2                   windowClientPosition  = geometry->GetClientPosition();
+        Vec2                   windowClientDimension = geometry->GetClientDimensions();
 
-        m_healthWidget = g_theWidgetSubsystem->CreateWidget<ButtonWidget>(g_theWidgetSubsystem, Stringf("Health=%d", m_health), (int)windowClientPosition.x, (int)windowClientPosition.y, (int)windowClientDimension.x, (int)windowClientDimension.y, m_color);
+        m_healthWidget = g_theWidgetSubsystem->CreateWidget<NumericTextWidget>("Health=%d", (int)windowClientPosition.x, (int)windowClientPosition.y, (int)windowClientDimension.x, (int)windowClientDimension.y, m_color);
+        m_healthWidget->BindValue(&m_health);
         g_theWidgetSubsystem->AddWidget(m_healthWidget, 200);
+        g_theWidgetSubsystem->SetWidgetAnchor(m_healthWidget, sWidgetAnchor::MakeWindowAnchor(windowID));
     }
 }
 
@@ -55,12 +58,11 @@ Triangle::~Triangle()
 
 void Triangle::UpdateWindowFocus()
 {
-    WindowID    windowID   = g_theWindowSubsystem->FindWindowIDByEntityID(m_entityID);
-    WindowData* windowData = g_theWindowSubsystem->GetWindowData(windowID);
+    Window* window = m_windowBinding.m_window;
 
-    if (windowData && windowData->m_window && windowData->m_window->GetWindowHandle())
+    if (window && window->GetWindowHandle())
     {
-        HWND hwnd = (HWND)windowData->m_window->GetWindowHandle();
+        HWND hwnd = (HWND)window->GetWindowHandle();
 
         // 只有在視窗失去焦點時才重新設定
         if (GetForegroundWindow() != hwnd)
@@ -78,13 +80,9 @@ void Triangle::Update(float const deltaSeconds)
 
     if (m_hasChildWindow)
     {
-        WindowID    windowID   = g_theWindowSubsystem->FindWindowIDByEntityID(m_entityID);
-        WindowData* windowData = g_theWindowSubsystem->GetWindowData(windowID);
-        m_healthWidget->SetPosition(windowData->m_window->GetClientPosition());
-        m_healthWidget->SetDimensions(windowData->m_window->GetClientDimensions());
-        m_healthWidget->SetText(Stringf("Health=%d", m_health));
+        sWindowGeometry const* geometry = GetWindowGeometry();
         // 然後用限制後的位置來設定視窗位置
-        windowData->m_window->SetClientPosition(m_position - windowData->m_window->GetClientDimensions() * 0.5f);
+        g_theWindowSubsystem->RequestClientPosition(m_windowBinding.m_windowID, m_position - geometry->GetClientDimensions() * 0.5f, m_velocity * m_speed);
     }
     if (m_isDead) return;
 
@@ -149,24 +147,18 @@ void Triangle::UpdateFromInput(float deltaSeconds)
     UNUSED(deltaSeconds)
 }
 
-void Triangle::ShrinkWindow()
+void Triangle::ShrinkWindow(float const deltaSeconds)
 {
-    WindowID windowID = g_theWindowSubsystem->FindWindowIDByEntityID(m_entityID);
-    Window*  window   = g_theWindowSubsystem->GetWindow(windowID);
+    WindowID               windowID = m_windowBinding.m_windowID;
+    sWindowGeometry const* geometry = GetWindowGeometry();
+    if (geometry == nullptr) return;
 
-    if (!g_theWindowSubsystem->IsWindowAnimating(windowID))
-    {
-        Vec2 currentPos              = window->GetWindowPosition();
-        Vec2 currentSize             = window->GetWindowDimensions();
-        Vec2 currentClientDimensions = window->GetClientDimensions();
-        if (currentClientDimensions.x <= m_physicRadius * 2.5f || currentClientDimensions.y <= m_physicRadius * 2.5f) return;
-
-        // 右邊界：增加寬度
-        Vec2 newPos  = currentPos + Vec2(1, 1);
-        Vec2 newSize = currentSize + Vec2(-1, -1);
-        g_theWindowSubsystem->AnimateWindowPositionAndDimensions(windowID, newPos, newSize, 0.1f);
-        // g_theWindowSubsystem->AnimateWindowDimensions(windowID,  newSize, 0.1f);
-    }
+    Vec2 currentClientDimensions = geometry->GetClientDimensions();
+    if (currentClientDimensions.x <= m_physicRadius * 2.5f || currentClientDimensions.y <= m_physicRadius * 2.5f) return;
+
+    // 每 0.1 秒縮 1 像素；連續請求會併入正在進行的動畫，而不是等動畫結束再重新開始
+    float const shrinkPixels = deltaSeconds * 10.f;
+    g_theWindowSubsystem->RequestWindowRectDelta(windowID, Vec2(shrinkPixels, shrinkPixels), Vec2(-shrinkPixels, -shrinkPixels), 0.1f);
 }
 
 STATIC bool Triangle::OnCollisionEnter(EventArgs& args)
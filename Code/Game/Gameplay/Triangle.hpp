@@ -6,10 +6,10 @@
 #pragma once
 
 #include "Engine/Core/EventSystem.hpp"
-#include "Game/Subsystem/Window/WindowSubsystem.hpp"
+#include "Game/Gameplay/Entity.hpp"
 
 //-Forward-Declaration--------------------------------------------------------------------------------
-class ButtonWidget;
+class NumericTextWidget;
 
 //----------------------------------------------------------------------------------------------------
 class Triangle : public Entity
@@ -22,9 +22,9 @@ public:
     void Render() const override;
     void BounceOfWindow();
     void UpdateFromInput(float deltaSeconds) override;
-    void ShrinkWindow();
+    void ShrinkWindow(float deltaSeconds);
 
 private:
     static bool OnCollisionEnter(EventArgs& args);
-    std::shared_ptr<ButtonWidget> m_healthWidget;
+    NumericTextWidget* m_healthWidget = nullptr;   // Owned by g_theWidgetSubsystem, released with MarkForDestroy
 };
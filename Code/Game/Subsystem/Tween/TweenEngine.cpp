@@ -0,0 +1,323 @@
+//----------------------------------------------------------------------------------------------------
+// TweenEngine.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Tween/TweenEngine.hpp"
+
+#include <algorithm>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Math/MathUtils.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static constexpr uint32_t INVALID_TWEEN_DENSE_INDEX = UINT32_MAX;
+static constexpr float    EASING_SLOPE_STEP         = 1.0e-3f;     // Half width of the finite difference in GetEasingSlope
+static constexpr float    MAX_RETARGET_ENTRY_T      = 0.9f;        // Keeps the extrapolated start value of a retarget finite
+static constexpr float    MAX_RETARGET_STRETCH      = 4.f;         // Longest a retarget may stretch its duration to enter slowly
+
+//----------------------------------------------------------------------------------------------------
+float ApplyEasing(eEasingType const easingType, float const t)
+{
+    switch (easingType)
+    {
+    case eEasingType::LINEAR: return t;
+    case eEasingType::SMOOTH_START_2: return SmoothStart2(t);
+    case eEasingType::SMOOTH_START_3: return SmoothStart3(t);
+    case eEasingType::SMOOTH_STOP_2: return SmoothStop2(t);
+    case eEasingType::SMOOTH_STOP_3: return SmoothStop3(t);
+    case eEasingType::SMOOTH_STEP_3: return SmoothStep3(t);
+    case eEasingType::SMOOTH_STEP_5: return SmoothStep5(t);
+    case eEasingType::COUNT: break;
+    }
+
+    return t;
+}
+
+//----------------------------------------------------------------------------------------------------
+// d(eased)/dt by central difference, so every easing is covered without a second table of derivatives.
+static float GetEasingSlope(eEasingType const easingType, float const t)
+{
+    float const t0 = std::max(t - EASING_SLOPE_STEP, 0.f);
+    float const t1 = std::min(t + EASING_SLOPE_STEP, 1.f);
+    return (ApplyEasing(easingType, t1) - ApplyEasing(easingType, t0)) / (t1 - t0);
+}
+
+// Slope at t relative to what is left of the curve, slope / (1 - eased). Grows with t for every easing.
+static float GetEasingSlopeToGo(eEasingType const easingType, float const t)
+{
+    return GetEasingSlope(easingType, t) / (1.f - ApplyEasing(easingType, t));
+}
+
+//----------------------------------------------------------------------------------------------------
+TweenID TweenEngine::Start(uint64_t const               targetKey,
+                           uint8_t const                channel,
+                           Vec2 const&                  from,
+                           Vec2 const&                  to,
+                           float const                  durationSeconds,
+                           eEasingType const            easingType,
+                           TweenCompleteCallback const& onComplete)
+{
+    TweenID const tweenID = m_nextTweenID++;
+    if (m_nextTweenID == 0) m_nextTweenID = 1;
+
+    // 同一個 (target, channel) 只保留一個補間，重新開始時直接覆寫（不觸發舊的完成回呼）
+    uint32_t denseIndex = FindDenseIndex(targetKey, channel);
+
+    if (denseIndex == INVALID_TWEEN_DENSE_INDEX)
+    {
+        denseIndex = static_cast<uint32_t>(m_tweenIDs.size());
+        m_denseIndexByLookupKey[MakeLookupKey(targetKey, channel)] = denseIndex;
+        m_activeChannelsByTarget[targetKey] |= static_cast<uint16_t>(1u << (channel & (MAX_CHANNELS - 1)));
+
+        m_tweenIDs.push_back(tweenID);
+        m_targetKeys.push_back(targetKey);
+        m_channels.push_back(channel);
+        m_easingTypes.push_back(easingType);
+        m_startValues.push_back(from);
+        m_targetValues.push_back(to);
+        m_currentValues.push_back(from);
+        m_elapsedSeconds.push_back(0.f);
+        m_durationSeconds.push_back(durationSeconds);
+        m_onCompletes.push_back(onComplete);
+    }
+    else
+    {
+        m_tweenIDs[denseIndex]        = tweenID;
+        m_easingTypes[denseIndex]     = easingType;
+        m_startValues[denseIndex]     = from;
+        m_targetValues[denseIndex]    = to;
+        m_currentValues[denseIndex]   = from;
+        m_elapsedSeconds[denseIndex]  = 0.f;
+        m_durationSeconds[denseIndex] = durationSeconds;
+        m_onCompletes[denseIndex]     = onComplete;
+    }
+
+    ++m_stats.m_startedCount;
+    return tweenID;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Continue from wherever the tween currently is toward a new target. The tween keeps its ID, easing
+// and completion callback, so the property never jumps back to the original start value.
+//
+// The new curve is not simply entered at t = 0, which would snap the speed to whatever the easing
+// starts with. It is entered at the t whose slope matches the current speed toward the new target, and
+// the start value is extrapolated backwards so the curve passes through the current value there; the
+// tween then arrives sooner than durationSeconds. Easings that start fast (LINEAR, SMOOTH_STOP_*) can
+// be too quick even at t = 0, so they stretch the duration instead, up to MAX_RETARGET_STRETCH times.
+// Velocity across the new direction cannot be carried by one eased segment and is dropped.
+bool TweenEngine::Retarget(uint64_t const targetKey, uint8_t const channel, Vec2 const& to, float const durationSeconds)
+{
+    uint32_t const denseIndex = FindDenseIndex(targetKey, channel);
+    if (denseIndex == INVALID_TWEEN_DENSE_INDEX) return false;
+
+    eEasingType const easingType  = m_easingTypes[denseIndex];
+    Vec2 const        current     = m_currentValues[denseIndex];
+    float const       oldDuration = m_durationSeconds[denseIndex];
+    float const       oldT        = oldDuration > 0.f ? std::min(m_elapsedSeconds[denseIndex] / oldDuration, 1.f) : 1.f;
+    Vec2 const        oldDelta    = m_targetValues[denseIndex] - m_startValues[denseIndex];
+    Vec2 const        velocity    = oldDuration > 0.f ? oldDelta * (GetEasingSlope(easingType, oldT) / oldDuration) : Vec2::ZERO;
+
+    Vec2 const  newDelta = to - current;
+    float const distance = newDelta.GetLength();
+    float       duration = durationSeconds;
+    float       entryT   = 0.f;
+
+    if (durationSeconds > 0.f && distance > 0.f)
+    {
+        // Speed toward the new target, in remaining distances per duration
+        float const entrySlope = DotProduct2D(velocity, newDelta) * durationSeconds / (distance * distance);
+        float const startSlope = GetEasingSlopeToGo(easingType, 0.f);
+
+        if (entrySlope > 0.f && entrySlope < startSlope)
+        {
+            duration = durationSeconds * std::min(startSlope / entrySlope, MAX_RETARGET_STRETCH);
+        }
+        else
+        {
+            entryT = FindRetargetEntryT(easingType, entrySlope);
+        }
+    }
+
+    float const easedEntryT = ApplyEasing(easingType, entryT);
+
+    m_startValues[denseIndex]     = current - newDelta * (easedEntryT / (1.f - easedEntryT));
+    m_targetValues[denseIndex]    = to;
+    m_elapsedSeconds[denseIndex]  = entryT * duration;
+    m_durationSeconds[denseIndex] = duration;
+
+    ++m_stats.m_retargetedCount;
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TweenEngine::Cancel(uint64_t const targetKey, uint8_t const channel)
+{
+    uint32_t const denseIndex = FindDenseIndex(targetKey, channel);
+    if (denseIndex == INVALID_TWEEN_DENSE_INDEX) return false;
+
+    RemoveAt(denseIndex);
+    ++m_stats.m_cancelledCount;
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void TweenEngine::CancelAll(uint64_t const targetKey)
+{
+    auto const it = m_activeChannelsByTarget.find(targetKey);
+    if (it == m_activeChannelsByTarget.end()) return;
+
+    // RemoveAt erases the entry once the last channel goes, so work from a copy of the mask
+    uint16_t const activeChannels = it->second;
+    for (uint8_t channel = 0; channel < MAX_CHANNELS; ++channel)
+    {
+        if (activeChannels & (1u << channel)) Cancel(targetKey, channel);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void TweenEngine::Clear()
+{
+    m_stats.m_cancelledCount += m_tweenIDs.size();
+
+    m_tweenIDs.clear();
+    m_targetKeys.clear();
+    m_channels.clear();
+    m_easingTypes.clear();
+    m_startValues.clear();
+    m_targetValues.clear();
+    m_currentValues.clear();
+    m_elapsedSeconds.clear();
+    m_durationSeconds.clear();
+    m_onCompletes.clear();
+    m_denseIndexByLookupKey.clear();
+    m_activeChannelsByTarget.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TweenEngine::IsActive(uint64_t const targetKey, uint8_t const channel) const
+{
+    return FindDenseIndex(targetKey, channel) != INVALID_TWEEN_DENSE_INDEX;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TweenEngine::IsAnyActive(uint64_t const targetKey) const
+{
+    return m_activeChannelsByTarget.find(targetKey) != m_activeChannelsByTarget.end();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TweenEngine::GetTargetValue(uint64_t const targetKey, uint8_t const channel, Vec2& out_targetValue) const
+{
+    uint32_t const denseIndex = FindDenseIndex(targetKey, channel);
+    if (denseIndex == INVALID_TWEEN_DENSE_INDEX) return false;
+
+    out_targetValue = m_targetValues[denseIndex];
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool TweenEngine::GetCurrentValue(uint64_t const targetKey, uint8_t const channel, Vec2& out_currentValue) const
+{
+    uint32_t const denseIndex = FindDenseIndex(targetKey, channel);
+    if (denseIndex == INVALID_TWEEN_DENSE_INDEX) return false;
+
+    out_currentValue = m_currentValues[denseIndex];
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t TweenEngine::GetActiveCount() const
+{
+    return m_tweenIDs.size();
+}
+
+//----------------------------------------------------------------------------------------------------
+sTweenStats const& TweenEngine::GetStats() const
+{
+    return m_stats;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC uint64_t TweenEngine::MakeLookupKey(uint64_t const targetKey, uint8_t const channel)
+{
+    return (targetKey << CHANNEL_BITS) | (channel & (MAX_CHANNELS - 1));
+}
+
+//----------------------------------------------------------------------------------------------------
+// Smallest t in [0, MAX_RETARGET_ENTRY_T] whose slope still to go reaches entrySlope, by bisection.
+STATIC float TweenEngine::FindRetargetEntryT(eEasingType const easingType, float const entrySlope)
+{
+    if (entrySlope <= GetEasingSlopeToGo(easingType, 0.f)) return 0.f;
+    if (entrySlope >= GetEasingSlopeToGo(easingType, MAX_RETARGET_ENTRY_T)) return MAX_RETARGET_ENTRY_T;
+
+    float lowT  = 0.f;
+    float highT = MAX_RETARGET_ENTRY_T;
+    for (int iteration = 0; iteration < 16; ++iteration)
+    {
+        float const midT = 0.5f * (lowT + highT);
+        if (GetEasingSlopeToGo(easingType, midT) < entrySlope) lowT = midT;
+        else highT = midT;
+    }
+
+    return highT;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t TweenEngine::FindDenseIndex(uint64_t const targetKey, uint8_t const channel) const
+{
+    if (m_tweenIDs.empty()) return INVALID_TWEEN_DENSE_INDEX;
+
+    auto const it = m_denseIndexByLookupKey.find(MakeLookupKey(targetKey, channel));
+    return it != m_denseIndexByLookupKey.end() ? it->second : INVALID_TWEEN_DENSE_INDEX;
+}
+
+//----------------------------------------------------------------------------------------------------
+void TweenEngine::RemoveAt(uint32_t const denseIndex)
+{
+    m_denseIndexByLookupKey.erase(MakeLookupKey(m_targetKeys[denseIndex], m_channels[denseIndex]));
+
+    auto const activeIt = m_activeChannelsByTarget.find(m_targetKeys[denseIndex]);
+    activeIt->second &= static_cast<uint16_t>(~(1u << (m_channels[denseIndex] & (MAX_CHANNELS - 1))));
+    if (activeIt->second == 0) m_activeChannelsByTarget.erase(activeIt);
+
+    uint32_t const lastIndex = static_cast<uint32_t>(m_tweenIDs.size() - 1);
+    if (denseIndex != lastIndex)
+    {
+        m_tweenIDs[denseIndex]        = m_tweenIDs[lastIndex];
+        m_targetKeys[denseIndex]      = m_targetKeys[lastIndex];
+        m_channels[denseIndex]        = m_channels[lastIndex];
+        m_easingTypes[denseIndex]     = m_easingTypes[lastIndex];
+        m_startValues[denseIndex]     = m_startValues[lastIndex];
+        m_targetValues[denseIndex]    = m_targetValues[lastIndex];
+        m_currentValues[denseIndex]   = m_currentValues[lastIndex];
+        m_elapsedSeconds[denseIndex]  = m_elapsedSeconds[lastIndex];
+        m_durationSeconds[denseIndex] = m_durationSeconds[lastIndex];
+        m_onCompletes[denseIndex]     = std::move(m_onCompletes[lastIndex]);
+
+        m_denseIndexByLookupKey[MakeLookupKey(m_targetKeys[denseIndex], m_channels[denseIndex])] = denseIndex;
+    }
+
+    m_tweenIDs.pop_back();
+    m_targetKeys.pop_back();
+    m_channels.pop_back();
+    m_easingTypes.pop_back();
+    m_startValues.pop_back();
+    m_targetValues.pop_back();
+    m_currentValues.pop_back();
+    m_elapsedSeconds.pop_back();
+    m_durationSeconds.pop_back();
+    m_onCompletes.pop_back();
+}
+
+//----------------------------------------------------------------------------------------------------
+void TweenEngine::FirePendingCallbacks()
+{
+    for (sPendingCallback const& pending : m_pendingCallbacks)
+    {
+        pending.m_callback(pending.m_tweenID, pending.m_targetKey, pending.m_channel);
+    }
+
+    m_pendingCallbacks.clear();
+}
@@ -0,0 +1,152 @@
+//----------------------------------------------------------------------------------------------------
+// TweenEngine.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "Engine/Math/Vec2.hpp"
+
+//----------------------------------------------------------------------------------------------------
+enum class eEasingType : uint8_t
+{
+    LINEAR,
+    SMOOTH_START_2,
+    SMOOTH_START_3,
+    SMOOTH_STOP_2,
+    SMOOTH_STOP_3,
+    SMOOTH_STEP_3,
+    SMOOTH_STEP_5,
+    COUNT
+};
+
+float ApplyEasing(eEasingType easingType, float t);
+
+//----------------------------------------------------------------------------------------------------
+typedef uint32_t TweenID;       // 0 is the invalid ID
+
+using TweenCompleteCallback = std::function<void(TweenID tweenID, uint64_t targetKey, uint8_t channel)>;
+
+//----------------------------------------------------------------------------------------------------
+struct sTweenStats
+{
+    uint64_t m_startedCount    = 0;
+    uint64_t m_retargetedCount = 0;     // In-flight tweens redirected instead of restarted
+    uint64_t m_completedCount  = 0;
+    uint64_t m_cancelledCount  = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Animates Vec2 properties of arbitrary targets. A target is an opaque key chosen by the owner (a
+// WindowID, a widget pointer, ...) and a channel picks the property on it, so at most one tween runs
+// per (target, channel). Active tweens are stored as parallel dense arrays and finished ones are
+// swap-removed, so Update touches nothing but live tweens.
+//
+// Values are pushed back to the owner through the functor passed to Update, which keeps the engine
+// unaware of what it animates:
+//
+//     m_tweens.Update(deltaSeconds, [](uint64_t targetKey, uint8_t channel, Vec2 const& value) { ... });
+//
+class TweenEngine
+{
+public:
+    static constexpr int      CHANNEL_BITS = 4;     // Target keys must fit in the remaining 60 bits
+    static constexpr uint8_t  MAX_CHANNELS = 1u << CHANNEL_BITS;
+
+    TweenID Start(uint64_t targetKey, uint8_t channel, Vec2 const& from, Vec2 const& to, float durationSeconds, eEasingType easingType = eEasingType::SMOOTH_STEP_5, TweenCompleteCallback const& onComplete = nullptr);
+    bool    Retarget(uint64_t targetKey, uint8_t channel, Vec2 const& to, float durationSeconds);
+    bool    Cancel(uint64_t targetKey, uint8_t channel);
+    void    CancelAll(uint64_t targetKey);
+    void    Clear();
+
+    template <typename ApplyFunc>
+    void Update(float deltaSeconds, ApplyFunc&& applyValue);
+
+    bool   IsActive(uint64_t targetKey, uint8_t channel) const;
+    bool   IsAnyActive(uint64_t targetKey) const;
+    bool   GetTargetValue(uint64_t targetKey, uint8_t channel, Vec2& out_targetValue) const;
+    bool   GetCurrentValue(uint64_t targetKey, uint8_t channel, Vec2& out_currentValue) const;
+    size_t GetActiveCount() const;
+
+    sTweenStats const& GetStats() const;
+
+private:
+    static uint64_t MakeLookupKey(uint64_t targetKey, uint8_t channel);
+    static float    FindRetargetEntryT(eEasingType easingType, float entrySlope);
+
+    uint32_t FindDenseIndex(uint64_t targetKey, uint8_t channel) const;
+    void     RemoveAt(uint32_t denseIndex);
+    void     FirePendingCallbacks();
+
+    // Active tweens, index i across every array is one tween
+    std::vector<TweenID>               m_tweenIDs;
+    std::vector<uint64_t>              m_targetKeys;
+    std::vector<uint8_t>               m_channels;
+    std::vector<eEasingType>           m_easingTypes;
+    std::vector<Vec2>                  m_startValues;
+    std::vector<Vec2>                  m_targetValues;
+    std::vector<Vec2>                  m_currentValues;
+    std::vector<float>                 m_elapsedSeconds;
+    std::vector<float>                 m_durationSeconds;
+    std::vector<TweenCompleteCallback> m_onCompletes;
+
+    std::unordered_map<uint64_t, uint32_t> m_denseIndexByLookupKey;     // (target, channel) -> dense index
+    std::unordered_map<uint64_t, uint16_t> m_activeChannelsByTarget;    // target -> bit per active channel, no entry when idle
+
+    struct sPendingCallback
+    {
+        TweenCompleteCallback m_callback;
+        TweenID               m_tweenID   = 0;
+        uint64_t              m_targetKey = 0;
+        uint8_t               m_channel   = 0;
+    };
+    std::vector<sPendingCallback> m_pendingCallbacks;     // Fired after the update pass so callbacks may start new tweens
+
+    TweenID     m_nextTweenID = 1;
+    sTweenStats m_stats;
+};
+
+//----------------------------------------------------------------------------------------------------
+template <typename ApplyFunc>
+void TweenEngine::Update(float const deltaSeconds, ApplyFunc&& applyValue)
+{
+    uint32_t denseIndex = 0;
+
+    while (denseIndex < static_cast<uint32_t>(m_tweenIDs.size()))
+    {
+        m_elapsedSeconds[denseIndex] += deltaSeconds;
+
+        float const duration   = m_durationSeconds[denseIndex];
+        bool const  isFinished = m_elapsedSeconds[denseIndex] >= duration;
+        float const t          = isFinished ? 1.f : m_elapsedSeconds[denseIndex] / duration;
+        float const easedT     = ApplyEasing(m_easingTypes[denseIndex], t);
+
+        Vec2 const& start  = m_startValues[denseIndex];
+        Vec2 const& target = m_targetValues[denseIndex];
+        m_currentValues[denseIndex] = start + (target - start) * easedT;
+
+        applyValue(m_targetKeys[denseIndex], m_channels[denseIndex], m_currentValues[denseIndex]);
+
+        if (!isFinished)
+        {
+            ++denseIndex;
+            continue;
+        }
+
+        if (m_onCompletes[denseIndex])
+        {
+            m_pendingCallbacks.push_back({std::move(m_onCompletes[denseIndex]), m_tweenIDs[denseIndex], m_targetKeys[denseIndex], m_channels[denseIndex]});
+        }
+
+        ++m_stats.m_completedCount;
+
+        // The last tween moves into this index and is updated next
+        RemoveAt(denseIndex);
+    }
+
+    FirePendingCallbacks();
+}
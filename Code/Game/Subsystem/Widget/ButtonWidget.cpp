@@ -5,8 +5,13 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Subsystem/Widget/ButtonWidget.hpp"
 
+#include "Engine/Core/EngineCommon.hpp"
 #include "Engine/Renderer/BitmapFont.hpp"
 #include "Engine/Renderer/Renderer.hpp"
+#include "Game/Subsystem/Widget/WidgetRenderBatcher.hpp"
+
+//----------------------------------------------------------------------------------------------------
+STATIC WidgetStats<eTextCacheStat> ButtonWidget::s_textCacheStats;
 
 ButtonWidget::ButtonWidget(WidgetSubsystem* owner, String const& text, int x, int y, int width, int height, Rgba8 const& color)
     : m_text(text),
@@ -18,6 +23,8 @@ ButtonWidget::ButtonWidget(WidgetSubsystem* owner, String const& text, int x, in
 {
     SetOwner(owner);
     SetName("ButtonWidget_" + text);
+    SetTick(false);     // Update 沒有事要做，游標事件由 WidgetSubsystem 送進來，不用進 Tick 串列
+    m_dirtyFlags = WIDGET_DIRTY_LAYOUT;
 }
 
 void ButtonWidget::Draw() const
@@ -27,25 +34,40 @@ void ButtonWidget::Draw() const
     // g_theRenderer->BindTexture(nullptr);
     // g_theRenderer->DrawVertexArray(verts1);
 
-    VertexList_PCU verts2;
-    // g_theBitmapFont->AddVertsForText2D(verts, m_text, Vec2(m_x, m_y), 20.f);
-    g_theBitmapFont->AddVertsForTextInBox2D(verts2, m_text, AABB2(Vec2(m_x, m_y), Vec2(m_x + m_width, m_y + m_height)), 20.f, m_color, 1.f, Vec2(1, 0), OVERRUN);
+    UpdateTextVerts();
+
     g_theRenderer->BindTexture(&g_theBitmapFont->GetTexture());
-    g_theRenderer->DrawVertexArray(verts2);
+    g_theRenderer->DrawVertexArray(m_textVerts);
+}
+
+bool ButtonWidget::AppendToBatch(WidgetRenderBatcher& batcher) const
+{
+    UpdateTextVerts();
+    batcher.AddVerts(m_textVerts, &g_theBitmapFont->GetTexture(), eBlendMode::ALPHA);
+    return true;
+}
+
+void ButtonWidget::ApplyLayout(AABB2 const& bounds)
+{
+    SetPosition(bounds.m_mins);
+    SetDimensions(bounds.m_maxs - bounds.m_mins);
+}
+
+bool ButtonWidget::GetHitBounds(AABB2& out_bounds) const
+{
+    out_bounds = AABB2(Vec2(m_x, m_y), Vec2(m_x + m_width, m_y + m_height));
+    return true;
 }
 
 void ButtonWidget::Update()
 {
-    // 處理按鈕邏輯，例如滑鼠懸停、點擊等
-    // if (Input::IsMouseInRect(m_x, m_y, m_width, m_height))
-    // {
-    //     // 處理懸停邏輯
-    // }
+    // 滑鼠懸停、點擊由 WidgetSubsystem 的 hit-test index 找出最上層的 Widget 後，
+    // 透過 OnCursorEnter / OnCursorLeave / OnCursorHover / OnCursorClick 通知，不需要每個按鈕自己測試游標
 }
 
 void ButtonWidget::SetText(String const& text)
 {
-    m_text = text;
+    SetProperty(m_text, text, WIDGET_DIRTY_TEXT);
 }
 
 String ButtonWidget::GetText() const
@@ -55,12 +77,79 @@ String ButtonWidget::GetText() const
 
 void ButtonWidget::SetPosition(Vec2 const& newPosition)
 {
-    m_x = (int)newPosition.x;
-    m_y = (int)newPosition.y;
+    // 只改位置不需要重新排版，Draw() 會平移快取的字形
+    SetProperty(m_x, (int)newPosition.x, WIDGET_DIRTY_POSITION);
+    SetProperty(m_y, (int)newPosition.y, WIDGET_DIRTY_POSITION);
 }
 
 void ButtonWidget::SetDimensions(Vec2 const& newDimensions)
 {
-    m_width  = (int)newDimensions.x;
-    m_height = (int)newDimensions.y;
+    SetProperty(m_width, (int)newDimensions.x, WIDGET_DIRTY_DIMENSIONS);
+    SetProperty(m_height, (int)newDimensions.y, WIDGET_DIRTY_DIMENSIONS);
+}
+
+void ButtonWidget::SetColor(Rgba8 const& color)
+{
+    SetProperty(m_color, color, WIDGET_DIRTY_COLOR);
+}
+
+STATIC WidgetStats<eTextCacheStat> const& ButtonWidget::GetTextCacheStats()
+{
+    return s_textCacheStats;
+}
+
+void ButtonWidget::UpdateTextVerts() const
+{
+    if (m_dirtyFlags & WIDGET_DIRTY_LAYOUT)
+    {
+        RebuildTextVerts();
+        return;
+    }
+
+    if (m_dirtyFlags == WIDGET_DIRTY_NONE)
+    {
+        s_textCacheStats.Increment(eTextCacheStat::REUSE);
+        return;
+    }
+
+    // 文字框平移時字形的相對位置不變，直接搬動快取的頂點
+    if (m_dirtyFlags & WIDGET_DIRTY_POSITION)
+    {
+        float const deltaX = static_cast<float>(m_x - m_cachedX);
+        float const deltaY = static_cast<float>(m_y - m_cachedY);
+
+        for (Vertex_PCU& vert : m_textVerts)
+        {
+            vert.m_position.x += deltaX;
+            vert.m_position.y += deltaY;
+        }
+
+        m_cachedX = m_x;
+        m_cachedY = m_y;
+        s_textCacheStats.Increment(eTextCacheStat::TRANSLATE);
+    }
+
+    if (m_dirtyFlags & WIDGET_DIRTY_COLOR)
+    {
+        for (Vertex_PCU& vert : m_textVerts)
+        {
+            vert.m_color = m_color;
+        }
+
+        s_textCacheStats.Increment(eTextCacheStat::RECOLOR);
+    }
+
+    m_dirtyFlags = WIDGET_DIRTY_NONE;
+}
+
+void ButtonWidget::RebuildTextVerts() const
+{
+    m_textVerts.clear();
+    // g_theBitmapFont->AddVertsForText2D(verts, m_text, Vec2(m_x, m_y), 20.f);
+    g_theBitmapFont->AddVertsForTextInBox2D(m_textVerts, m_text, AABB2(Vec2(m_x, m_y), Vec2(m_x + m_width, m_y + m_height)), 20.f, m_color, 1.f, Vec2(1, 0), OVERRUN);
+
+    m_cachedX    = m_x;
+    m_cachedY    = m_y;
+    m_dirtyFlags = WIDGET_DIRTY_NONE;
+    s_textCacheStats.Increment(eTextCacheStat::REBUILD);
 }
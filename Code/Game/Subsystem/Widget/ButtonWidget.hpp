@@ -6,9 +6,20 @@
 #pragma once
 #include "Engine/Core/Rgba8.hpp"
 #include "Engine/Core/StringUtils.hpp"
+#include "Engine/Renderer/VertexUtils.hpp"
 #include "Game/Framework/GameCommon.hpp"
 #include "Game/Subsystem/Widget/IWidget.hpp"
 
+//----------------------------------------------------------------------------------------------------
+enum class eTextCacheStat : uint8_t
+{
+    REBUILD,       // Text laid out again because the text or box size changed
+    TRANSLATE,     // Cached glyphs moved because only the position changed
+    RECOLOR,       // Cached glyphs recoloured because only the colour changed
+    REUSE,         // Drawn straight from the cache
+    COUNT
+};
+
 //----------------------------------------------------------------------------------------------------
 class ButtonWidget : public IWidget
 {
@@ -16,15 +27,33 @@ public:
     ButtonWidget(WidgetSubsystem* owner, String const& text, int x, int y, int width, int height, Rgba8 const& color);
 
     void Draw() const override;
+    bool AppendToBatch(WidgetRenderBatcher& batcher) const override;
+    void ApplyLayout(AABB2 const& bounds) override;
+    bool GetHitBounds(AABB2& out_bounds) const override;
     void Update() override;
 
     void   SetText(String const& text);
     String GetText() const;
     void   SetPosition(Vec2 const& newPosition);
     void   SetDimensions(Vec2 const& newDimensions);
+    void   SetColor(Rgba8 const& color);
+
+    /// Glyph cache counters shared by every ButtonWidget, the frame counts are reset by WidgetSubsystem::BeginFrame
+    static WidgetStats<eTextCacheStat> const& GetTextCacheStats();
 
 private:
+    void UpdateTextVerts() const;
+    void RebuildTextVerts() const;
+
     String m_text;
     int    m_x, m_y, m_width, m_height;
     Rgba8  m_color;
+
+    // Glyphs as laid out at (m_cachedX, m_cachedY). Draw() reads m_dirtyFlags: it shifts or recolours them in
+    // place when only the position or colour changed, and lays the text out again only when text or size change.
+    mutable VertexList_PCU m_textVerts;
+    mutable int            m_cachedX = 0;
+    mutable int            m_cachedY = 0;
+
+    static WidgetStats<eTextCacheStat> s_textCacheStats;
 };
@@ -10,6 +10,10 @@
 //----------------------------------------------------------------------------------------------------
 
 #include "WidgetSubsystem.hpp"
+#include "Engine/Core/EngineCommon.hpp"
+
+//----------------------------------------------------------------------------------------------------
+STATIC WidgetStats<eWidgetPropertyStat> IWidget::s_propertyStats;
 
 //----------------------------------------------------------------------------------------------------
 // Widget Implementation
@@ -41,6 +45,45 @@ void IWidget::Draw() const
     // 子類別必須實作此函數來繪製 UI
 }
 
+bool IWidget::AppendToBatch(WidgetRenderBatcher& batcher) const
+{
+    // 沒有覆蓋此函數的 Widget 走 Draw()，在原本的順序上自己繪製
+    (void)batcher;
+    return false;
+}
+
+void IWidget::ApplyLayout(AABB2 const& bounds)
+{
+    // 子類別可以覆蓋此函數，把 anchor 算出的範圍套用到自己的位置與尺寸
+    (void)bounds;
+}
+
+bool IWidget::GetHitBounds(AABB2& out_bounds) const
+{
+    (void)out_bounds;
+    return false;
+}
+
+void IWidget::OnCursorEnter()
+{
+    // 子類別可以覆蓋此函數
+}
+
+void IWidget::OnCursorLeave()
+{
+    // 子類別可以覆蓋此函數
+}
+
+void IWidget::OnCursorHover(Vec2 const& cursorPosition)
+{
+    (void)cursorPosition;
+}
+
+void IWidget::OnCursorClick(Vec2 const& cursorPosition)
+{
+    (void)cursorPosition;
+}
+
 void IWidget::Update()
 {
     // 子類別可以覆蓋此函數
@@ -51,6 +94,11 @@ void IWidget::EndFrame()
     // 子類別可以覆蓋此函數
 }
 
+WidgetHandle IWidget::GetHandle() const
+{
+    return m_handle;
+}
+
 void* IWidget::GetOwner() const
 {
     return m_owner;
@@ -76,6 +124,11 @@ bool IWidget::IsTick() const
     return m_bIsTick;
 }
 
+bool IWidget::WantsFrameHooks() const
+{
+    return m_bWantsFrameHooks;
+}
+
 bool IWidget::IsGarbage() const
 {
     return m_bIsGarbage;
@@ -88,27 +141,73 @@ void IWidget::SetOwner(void* owner)
 
 void IWidget::SetZOrder(int zOrder)
 {
-    if (m_zOrder != zOrder)
+    if (SetProperty(m_zOrder, zOrder) && m_subsystem != nullptr)
     {
-        m_zOrder = zOrder;
-        // 通知 WidgetSubsystem 需要重新排序
-        // m_owner->m_bNeedsSorting = true;
+        // 通知 WidgetSubsystem 把這個 Widget 搬到新的 Layer（尚未 AddWidget 時不做任何事）
+        m_subsystem->MoveWidgetToLayer(m_handle, zOrder);
     }
 }
 
 void IWidget::SetName(const String& name)
 {
-    m_name = name;
+    SetProperty(m_name, name);
 }
 
 void IWidget::SetVisible(bool visible)
 {
-    m_bIsVisible = visible;
+    if (SetProperty(m_bIsVisible, visible))
+    {
+        // 隱藏的 Widget 不能被點到，要從 hit-test index 移除，也不再留在繪製用的 Layer 裡
+        NotifyBoundsChanged();
+        NotifyListMembershipChanged();
+    }
 }
 
 void IWidget::SetTick(bool tick)
 {
-    m_bIsTick = tick;
+    if (SetProperty(m_bIsTick, tick))
+    {
+        NotifyListMembershipChanged();
+    }
+}
+
+void IWidget::SetWantsFrameHooks(bool wantsFrameHooks)
+{
+    if (SetProperty(m_bWantsFrameHooks, wantsFrameHooks))
+    {
+        NotifyListMembershipChanged();
+    }
+}
+
+uint8_t IWidget::GetDirtyFlags() const
+{
+    return m_dirtyFlags;
+}
+
+STATIC WidgetStats<eWidgetPropertyStat> const& IWidget::GetPropertyStats()
+{
+    return s_propertyStats;
+}
+
+void IWidget::NotifyBoundsChanged() const
+{
+    if (m_subsystem != nullptr)
+    {
+        m_subsystem->QueueWidgetHitBoundsUpdate(m_handle);
+    }
+}
+
+void IWidget::NotifyListMembershipChanged() const
+{
+    if (m_subsystem != nullptr)
+    {
+        m_subsystem->RefreshWidgetLists(m_handle);
+    }
+}
+
+STATIC void IWidget::RecordPropertySet(bool const isChanged)
+{
+    s_propertyStats.Increment(isChanged ? eWidgetPropertyStat::APPLIED : eWidgetPropertyStat::SUPPRESSED);
 }
 
 // void IWidget::AddToViewport(int zOrder)
@@ -132,5 +231,15 @@ void IWidget::SetTick(bool tick)
 
 void IWidget::MarkForDestroy()
 {
+    if (m_bIsGarbage) return;
+
     m_bIsGarbage = true;
+
+    // 交給 WidgetSubsystem 在下一次 Update 時回收，沒有被標記時 Update 不做任何清理；
+    // 在那之前先離開 Tick / Frame hook / Layer，這一幀剩下的階段就不會再走到它
+    if (m_subsystem != nullptr)
+    {
+        m_subsystem->QueueWidgetDestroy(m_handle);
+        m_subsystem->RefreshWidgetLists(m_handle);
+    }
 }
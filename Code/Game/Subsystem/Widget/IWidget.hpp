@@ -3,10 +3,40 @@
 //----------------------------------------------------------------------------------------------------
 
 #pragma once
+#include <cstdint>
+
 #include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Game/Subsystem/Widget/WidgetStats.hpp"
 
 //-Forward-Declaration--------------------------------------------------------------------------------
 class Entity;
+class WidgetRenderBatcher;
+class WidgetSubsystem;
+
+//----------------------------------------------------------------------------------------------------
+using WidgetHandle = uint32_t;
+
+//----------------------------------------------------------------------------------------------------
+// What a real property change invalidates. Setters called with the current value set nothing.
+enum eWidgetDirtyFlag : uint8_t
+{
+    WIDGET_DIRTY_NONE       = 0,
+    WIDGET_DIRTY_TEXT       = 1 << 0,     // Cached layout must be rebuilt
+    WIDGET_DIRTY_DIMENSIONS = 1 << 1,     // Cached layout must be rebuilt
+    WIDGET_DIRTY_POSITION   = 1 << 2,     // Cached geometry can be translated
+    WIDGET_DIRTY_COLOR      = 1 << 3,     // Cached geometry can be recoloured
+    WIDGET_DIRTY_LAYOUT     = WIDGET_DIRTY_TEXT | WIDGET_DIRTY_DIMENSIONS,
+    WIDGET_DIRTY_BOUNDS     = WIDGET_DIRTY_POSITION | WIDGET_DIRTY_DIMENSIONS     // Hit-test rect must be re-indexed
+};
+
+//----------------------------------------------------------------------------------------------------
+enum class eWidgetPropertyStat : uint8_t
+{
+    SUPPRESSED,     // Setter called with the value the widget already had
+    APPLIED,
+    COUNT
+};
 
 //----------------------------------------------------------------------------------------------------
 class IWidget
@@ -20,15 +50,28 @@ public:
     virtual void BeginFrame();
     virtual void Render();
     virtual void Draw() const;
+    /// Appends this frame's geometry to the shared widget batch. Returns false to be drawn with Draw() instead.
+    virtual bool AppendToBatch(WidgetRenderBatcher& batcher) const;
+    /// Called by WidgetSubsystem's layout pass when an anchored widget's bounds change.
+    virtual void ApplyLayout(AABB2 const& bounds);
+
+    /// Cursor input. Widgets that return false from GetHitBounds are never indexed and never receive these.
+    virtual bool GetHitBounds(AABB2& out_bounds) const;
+    virtual void OnCursorEnter();
+    virtual void OnCursorLeave();
+    virtual void OnCursorHover(Vec2 const& cursorPosition);
+    virtual void OnCursorClick(Vec2 const& cursorPosition);
     virtual void Update();
     virtual void EndFrame();
 
     /// Getter
+    WidgetHandle   GetHandle() const;
     virtual void*  GetOwner() const;
     virtual int    GetZOrder() const;
     virtual String GetName() const;
     virtual bool   IsVisible() const;
     virtual bool   IsTick() const;
+    virtual bool   WantsFrameHooks() const;
     virtual bool   IsGarbage() const;
 
     /// Setter
@@ -37,6 +80,13 @@ public:
     virtual void SetName(String const& name);
     virtual void SetVisible(bool visible);
     virtual void SetTick(bool tick);
+    virtual void SetWantsFrameHooks(bool wantsFrameHooks);
+
+    /// Dirty Tracking
+    uint8_t GetDirtyFlags() const;
+
+    /// Property set counters shared by every widget, the frame counts are reset by WidgetSubsystem::BeginFrame
+    static WidgetStats<eWidgetPropertyStat> const& GetPropertyStats();
 
     /// Viewport Management
     // virtual void AddToViewport(int zOrder = 0);
@@ -47,10 +97,48 @@ public:
     virtual void MarkForDestroy();
 
 protected:
-    void*  m_owner      = nullptr;
-    int    m_zOrder     = 0;       // 渲染順序，數字越大越在前面
-    bool   m_bIsTick    = true;    // 是否需要 Update
-    String m_name       = "DEFAULT";
-    bool   m_bIsVisible = true;    // 是否可見
-    bool   m_bIsGarbage = false;   // 是否標記為垃圾回收
+    /// Assigns and marks dirtyFlags only when the value differs, so per-frame pushes of unchanged values are free.
+    template <typename T>
+    bool SetProperty(T& property, T const& value, uint8_t dirtyFlags = WIDGET_DIRTY_NONE);
+
+    static void RecordPropertySet(bool isChanged);
+    void        NotifyBoundsChanged() const;
+    void        NotifyListMembershipChanged() const;
+
+    void*  m_owner            = nullptr;
+    int    m_zOrder           = 0;       // 渲染順序，數字越大越在前面
+    bool   m_bIsTick          = true;    // 是否需要 Update
+    String m_name             = "DEFAULT";
+    bool   m_bIsVisible       = true;    // 是否可見
+    bool   m_bIsGarbage       = false;   // 是否標記為垃圾回收
+    bool   m_bWantsFrameHooks = false;   // 是否需要 BeginFrame / EndFrame
+
+    mutable uint8_t m_dirtyFlags = WIDGET_DIRTY_NONE;     // Cleared by whoever rebuilds the caches
+
+    // Set when WidgetSubsystem::CreateWidget adopts the widget into its pool
+    WidgetSubsystem* m_subsystem = nullptr;
+    WidgetHandle     m_handle    = 0;
+
+    static WidgetStats<eWidgetPropertyStat> s_propertyStats;
 };
+
+//----------------------------------------------------------------------------------------------------
+template <typename T>
+bool IWidget::SetProperty(T& property, T const& value, uint8_t const dirtyFlags)
+{
+    if (property == value)
+    {
+        RecordPropertySet(false);
+        return false;
+    }
+
+    property = value;
+    m_dirtyFlags |= dirtyFlags;
+    RecordPropertySet(true);
+
+    if (dirtyFlags & WIDGET_DIRTY_BOUNDS)
+    {
+        NotifyBoundsChanged();
+    }
+    return true;
+}
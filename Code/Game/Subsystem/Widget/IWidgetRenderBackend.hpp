@@ -0,0 +1,30 @@
+//----------------------------------------------------------------------------------------------------
+// IWidgetRenderBackend.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Engine/Renderer/Renderer.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class IWidget;
+class Texture;
+
+//----------------------------------------------------------------------------------------------------
+// Everything WidgetRenderBatcher sends to the GPU goes through this interface, so the batching can be
+// checked against RecordingWidgetRenderBackend without a device.
+//
+class IWidgetRenderBackend
+{
+public:
+    virtual ~IWidgetRenderBackend() = default;
+
+    /// Called once per WidgetSubsystem::Render before any batch, sets the state every batch shares.
+    virtual void BeginWidgetPass() = 0;
+    virtual void SetBlendMode(eBlendMode blendMode) = 0;
+    virtual void BindTexture(Texture const* texture) = 0;
+    virtual void DrawVertexArray(int vertexCount, Vertex_PCU const* vertexes) = 0;
+
+    /// Widgets that cannot append to a batch draw themselves in place. They may change any render state.
+    virtual void DrawUnbatchedWidget(IWidget const& widget) = 0;
+};
@@ -0,0 +1,406 @@
+//----------------------------------------------------------------------------------------------------
+// NumericTextWidget.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Widget/NumericTextWidget.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Renderer/BitmapFont.hpp"
+#include "Engine/Renderer/Renderer.hpp"
+#include "Game/Subsystem/Widget/WidgetRenderBatcher.hpp"
+
+//----------------------------------------------------------------------------------------------------
+STATIC WidgetStats<eNumericTextStat> NumericTextWidget::s_numericTextStats;
+
+//----------------------------------------------------------------------------------------------------
+static constexpr int     MAX_NUMERIC_TEXT_PRECISION                    = 6;
+static constexpr int64_t POWERS_OF_TEN[MAX_NUMERIC_TEXT_PRECISION + 1] = {1, 10, 100, 1000, 10000, 100000, 1000000};
+
+//----------------------------------------------------------------------------------------------------
+// Returns the length of the placeholder starting at format[start] ('%'), or 0 if it is not one.
+static int ParsePlaceholder(String const& format, size_t const start, int& out_precision)
+{
+    size_t const remaining = format.size() - start;
+
+    if (remaining >= 2 && (format[start + 1] == 'd' || format[start + 1] == 'i'))
+    {
+        out_precision = 0;
+        return 2;
+    }
+
+    if (remaining >= 2 && format[start + 1] == 'f')
+    {
+        out_precision = MAX_NUMERIC_TEXT_PRECISION;
+        return 2;
+    }
+
+    if (remaining >= 4 && format[start + 1] == '.' && format[start + 2] >= '0' && format[start + 2] <= '9' && format[start + 3] == 'f')
+    {
+        out_precision = std::min(format[start + 2] - '0', MAX_NUMERIC_TEXT_PRECISION);
+        return 4;
+    }
+
+    return 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Writes scaledValue / 10^precision with exactly precision decimals, e.g. (-5, 2) -> "-0.05". Returns the length.
+static int WriteScaledValue(char* out, int const capacity, int64_t const scaledValue, int const precision)
+{
+    char     digits[24];
+    int      digitCount = 0;
+    uint64_t magnitude  = scaledValue < 0 ? 0ull - static_cast<uint64_t>(scaledValue) : static_cast<uint64_t>(scaledValue);
+
+    // 從個位數往前產生，至少要有 precision + 1 位，小數點前才會有 0
+    do
+    {
+        digits[digitCount++] = static_cast<char>('0' + magnitude % 10);
+        magnitude /= 10;
+    }
+    while (magnitude != 0 || digitCount <= precision);
+
+    int length = 0;
+    if (scaledValue < 0 && length < capacity) out[length++] = '-';
+
+    for (int digitIndex = digitCount - 1; digitIndex >= 0 && length < capacity; --digitIndex)
+    {
+        if (digitIndex == precision - 1)
+        {
+            out[length++] = '.';
+            if (length == capacity) break;
+        }
+        out[length++] = digits[digitIndex];
+    }
+
+    return length;
+}
+
+//----------------------------------------------------------------------------------------------------
+static int64_t ReadScaledValue(sNumericTextBinding const& binding)
+{
+    if (binding.m_type == eNumericTextSource::INT)
+    {
+        return static_cast<int64_t>(*static_cast<int const*>(binding.m_source)) * POWERS_OF_TEN[binding.m_precision];
+    }
+
+    // 先四捨五入到顯示的位數再比較，低於精度的浮點數變動不算改變；NaN 與超出範圍的值顯示為 0
+    double const scaled = static_cast<double>(*static_cast<float const*>(binding.m_source)) * static_cast<double>(POWERS_OF_TEN[binding.m_precision]);
+    return scaled > -9.0e18 && scaled < 9.0e18 ? std::llround(scaled) : 0;
+}
+
+//----------------------------------------------------------------------------------------------------
+NumericTextWidget::NumericTextWidget(String const& format, int const x, int const y, int const width, int const height, Rgba8 const& color)
+    : m_format(format),
+      m_x(x),
+      m_y(y),
+      m_width(width),
+      m_height(height),
+      m_color(color)
+{
+    SetName("NumericTextWidget_" + format);
+    m_glyphString = " ";
+    m_textVerts.reserve(NUMERIC_TEXT_CAPACITY * 6);
+    m_text[0] = '\0';
+
+    ParseFormat();
+    FormatText();
+    m_changedGlyphMask = 0;
+    m_dirtyFlags       = WIDGET_DIRTY_LAYOUT;
+}
+
+void NumericTextWidget::Draw() const
+{
+    UpdateTextVerts();
+
+    g_theRenderer->BindTexture(&g_theBitmapFont->GetTexture());
+    g_theRenderer->DrawVertexArray(m_textVerts);
+}
+
+bool NumericTextWidget::AppendToBatch(WidgetRenderBatcher& batcher) const
+{
+    UpdateTextVerts();
+    batcher.AddVerts(m_textVerts, &g_theBitmapFont->GetTexture(), eBlendMode::ALPHA);
+    return true;
+}
+
+void NumericTextWidget::ApplyLayout(AABB2 const& bounds)
+{
+    SetPosition(bounds.m_mins);
+    SetDimensions(bounds.m_maxs - bounds.m_mins);
+}
+
+void NumericTextWidget::Update()
+{
+    // 數值沒變的幀只比較幾個整數，不格式化也不碰頂點
+    if (!PollBoundValues())
+    {
+        s_numericTextStats.Increment(eNumericTextStat::UNCHANGED);
+        return;
+    }
+
+    FormatText();
+}
+
+void NumericTextWidget::BindValue(int const* source)
+{
+    if (source == nullptr || m_boundCount >= m_placeholderCount) return;
+
+    sNumericTextBinding& binding = m_bindings[m_boundCount++];
+    binding.m_type               = eNumericTextSource::INT;
+    binding.m_source             = source;
+    binding.m_scaledValue        = ReadScaledValue(binding);
+    FormatText();
+}
+
+void NumericTextWidget::BindValue(float const* source)
+{
+    if (source == nullptr || m_boundCount >= m_placeholderCount) return;
+
+    sNumericTextBinding& binding = m_bindings[m_boundCount++];
+    binding.m_type               = eNumericTextSource::FLOAT;
+    binding.m_source             = source;
+    binding.m_scaledValue        = ReadScaledValue(binding);
+    FormatText();
+}
+
+void NumericTextWidget::ClearBindings()
+{
+    for (int bindingIndex = 0; bindingIndex < m_boundCount; ++bindingIndex)
+    {
+        m_bindings[bindingIndex].m_type   = eNumericTextSource::NONE;
+        m_bindings[bindingIndex].m_source = nullptr;
+    }
+    m_boundCount = 0;
+    FormatText();
+}
+
+char const* NumericTextWidget::GetText() const
+{
+    return m_text;
+}
+
+void NumericTextWidget::SetPosition(Vec2 const& newPosition)
+{
+    SetProperty(m_x, (int)newPosition.x, WIDGET_DIRTY_POSITION);
+    SetProperty(m_y, (int)newPosition.y, WIDGET_DIRTY_POSITION);
+}
+
+void NumericTextWidget::SetDimensions(Vec2 const& newDimensions)
+{
+    SetProperty(m_width, (int)newDimensions.x, WIDGET_DIRTY_DIMENSIONS);
+    SetProperty(m_height, (int)newDimensions.y, WIDGET_DIRTY_DIMENSIONS);
+}
+
+void NumericTextWidget::SetColor(Rgba8 const& color)
+{
+    SetProperty(m_color, color, WIDGET_DIRTY_COLOR);
+}
+
+STATIC WidgetStats<eNumericTextStat> const& NumericTextWidget::GetNumericTextStats()
+{
+    return s_numericTextStats;
+}
+
+void NumericTextWidget::ParseFormat()
+{
+    // 只在建構時解析一次，記下每個 placeholder 的小數位數
+    m_placeholderCount = 0;
+
+    for (size_t charIndex = 0; charIndex < m_format.size(); ++charIndex)
+    {
+        if (m_format[charIndex] != '%') continue;
+
+        if (charIndex + 1 < m_format.size() && m_format[charIndex + 1] == '%')
+        {
+            ++charIndex;
+            continue;
+        }
+
+        int       precision = 0;
+        int const length    = ParsePlaceholder(m_format, charIndex, precision);
+        if (length == 0 || m_placeholderCount == NUMERIC_TEXT_MAX_BINDINGS) continue;
+
+        m_bindings[m_placeholderCount++].m_precision = precision;
+        charIndex += length - 1;
+    }
+}
+
+bool NumericTextWidget::PollBoundValues()
+{
+    bool isChanged = false;
+
+    for (int bindingIndex = 0; bindingIndex < m_boundCount; ++bindingIndex)
+    {
+        sNumericTextBinding& binding     = m_bindings[bindingIndex];
+        int64_t const        scaledValue = ReadScaledValue(binding);
+        if (scaledValue != binding.m_scaledValue)
+        {
+            binding.m_scaledValue = scaledValue;
+            isChanged             = true;
+        }
+    }
+
+    return isChanged;
+}
+
+void NumericTextWidget::FormatText()
+{
+    char      text[NUMERIC_TEXT_CAPACITY];
+    int const capacity     = NUMERIC_TEXT_CAPACITY - 1;
+    int       length       = 0;
+    int       bindingIndex = 0;
+
+    for (size_t charIndex = 0; charIndex < m_format.size() && length < capacity; ++charIndex)
+    {
+        char const c = m_format[charIndex];
+        if (c != '%')
+        {
+            text[length++] = c;
+            continue;
+        }
+
+        if (charIndex + 1 < m_format.size() && m_format[charIndex + 1] == '%')
+        {
+            text[length++] = '%';
+            ++charIndex;
+            continue;
+        }
+
+        int       precision         = 0;
+        int const placeholderLength = ParsePlaceholder(m_format, charIndex, precision);
+        if (placeholderLength == 0 || bindingIndex == m_placeholderCount)
+        {
+            text[length++] = c;
+            continue;
+        }
+
+        sNumericTextBinding const& binding = m_bindings[bindingIndex++];
+        if (binding.m_type == eNumericTextSource::NONE)
+        {
+            text[length++] = '?';
+        }
+        else
+        {
+            length += WriteScaledValue(text + length, capacity - length, binding.m_scaledValue, binding.m_precision);
+        }
+        charIndex += placeholderLength - 1;
+    }
+    text[length] = '\0';
+
+    // 長度不同時整行要重新排版（靠右對齊）；長度相同時只標記真正改變的字元
+    if (length != m_textLength)
+    {
+        m_dirtyFlags |= WIDGET_DIRTY_TEXT;
+    }
+    else
+    {
+        for (int glyphIndex = 0; glyphIndex < length; ++glyphIndex)
+        {
+            if (text[glyphIndex] != m_text[glyphIndex])
+            {
+                m_changedGlyphMask |= 1ull << glyphIndex;
+            }
+        }
+    }
+
+    std::memcpy(m_text, text, static_cast<size_t>(length) + 1);
+    m_textLength = length;
+
+    s_numericTextStats.Increment(eNumericTextStat::FORMAT);
+}
+
+void NumericTextWidget::UpdateTextVerts() const
+{
+    if (m_dirtyFlags & WIDGET_DIRTY_LAYOUT)
+    {
+        RebuildTextVerts();
+        return;
+    }
+
+    // 先平移整行，之後重新產生的字形直接用新的位置
+    if (m_dirtyFlags & WIDGET_DIRTY_POSITION)
+    {
+        float const deltaX = static_cast<float>(m_x - m_cachedX);
+        float const deltaY = static_cast<float>(m_y - m_cachedY);
+
+        for (Vertex_PCU& vert : m_textVerts)
+        {
+            vert.m_position.x += deltaX;
+            vert.m_position.y += deltaY;
+        }
+
+        m_cachedX = m_x;
+        m_cachedY = m_y;
+    }
+
+    if (m_dirtyFlags & WIDGET_DIRTY_COLOR)
+    {
+        for (Vertex_PCU& vert : m_textVerts)
+        {
+            vert.m_color = m_color;
+        }
+    }
+
+    for (int glyphIndex = 0; m_changedGlyphMask != 0; ++glyphIndex)
+    {
+        if ((m_changedGlyphMask & (1ull << glyphIndex)) == 0) continue;
+
+        m_changedGlyphMask &= ~(1ull << glyphIndex);
+        if (!WriteGlyphVerts(glyphIndex))
+        {
+            RebuildTextVerts();
+            return;
+        }
+    }
+
+    m_dirtyFlags = WIDGET_DIRTY_NONE;
+}
+
+void NumericTextWidget::RebuildTextVerts() const
+{
+    m_textVerts.clear();
+    m_glyphVertexCount = 0;
+
+    for (int glyphIndex = 0; glyphIndex < m_textLength; ++glyphIndex)
+    {
+        m_glyphScratch.clear();
+        m_glyphString[0] = m_text[glyphIndex];
+        g_theBitmapFont->AddVertsForText2D(m_glyphScratch, m_glyphString, GetGlyphMins(glyphIndex), m_cellHeight, m_color, 1.f);
+
+        m_glyphVertexCount = static_cast<int>(m_glyphScratch.size());
+        m_textVerts.insert(m_textVerts.end(), m_glyphScratch.begin(), m_glyphScratch.end());
+    }
+
+    m_cachedX          = m_x;
+    m_cachedY          = m_y;
+    m_changedGlyphMask = 0;
+    m_dirtyFlags       = WIDGET_DIRTY_NONE;
+    s_numericTextStats.Increment(eNumericTextStat::RELAYOUT);
+}
+
+bool NumericTextWidget::WriteGlyphVerts(int const glyphIndex) const
+{
+    m_glyphScratch.clear();
+    m_glyphString[0] = m_text[glyphIndex];
+    g_theBitmapFont->AddVertsForText2D(m_glyphScratch, m_glyphString, GetGlyphMins(glyphIndex), m_cellHeight, m_color, 1.f);
+
+    // 每個字元的頂點數不一致時無法原地替換，交給呼叫端整行重建
+    size_t const firstVert = static_cast<size_t>(glyphIndex) * static_cast<size_t>(m_glyphVertexCount);
+    if (static_cast<int>(m_glyphScratch.size()) != m_glyphVertexCount || firstVert + m_glyphScratch.size() > m_textVerts.size()) return false;
+
+    std::copy(m_glyphScratch.begin(), m_glyphScratch.end(), m_textVerts.begin() + static_cast<std::ptrdiff_t>(firstVert));
+    s_numericTextStats.Increment(eNumericTextStat::GLYPH);
+    return true;
+}
+
+Vec2 NumericTextWidget::GetGlyphMins(int const glyphIndex) const
+{
+    // 與 ButtonWidget 相同：文字靠右下對齊，字寬等於字高
+    float const right = static_cast<float>(m_x + m_width);
+    return Vec2(right - static_cast<float>(m_textLength - glyphIndex) * m_cellHeight, static_cast<float>(m_y));
+}
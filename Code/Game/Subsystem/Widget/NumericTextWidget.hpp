@@ -0,0 +1,109 @@
+//----------------------------------------------------------------------------------------------------
+// NumericTextWidget.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Engine/Core/Rgba8.hpp"
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Renderer/VertexUtils.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Subsystem/Widget/IWidget.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static constexpr int NUMERIC_TEXT_CAPACITY     = 64;     // Formatted text is truncated to NUMERIC_TEXT_CAPACITY - 1 glyphs
+static constexpr int NUMERIC_TEXT_MAX_BINDINGS = 4;
+
+//----------------------------------------------------------------------------------------------------
+enum class eNumericTextSource : uint8_t
+{
+    NONE,
+    INT,
+    FLOAT
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sNumericTextBinding
+{
+    eNumericTextSource m_type        = eNumericTextSource::NONE;
+    void const*        m_source      = nullptr;
+    int                m_precision   = 0;     // Digits after the decimal point, from the format's placeholder
+    int64_t            m_scaledValue = 0;     // Value * 10^precision as last formatted, so sub-precision float drift is not a change
+};
+
+//----------------------------------------------------------------------------------------------------
+enum class eNumericTextStat : uint8_t
+{
+    UNCHANGED,     // Update found every bound value as last formatted
+    FORMAT,        // Text formatted again because a bound value changed
+    GLYPH,         // Glyphs regenerated in place
+    RELAYOUT,      // Text laid out again because its length or box size changed
+    COUNT
+};
+
+//----------------------------------------------------------------------------------------------------
+// Single-line HUD text such as "Health=%d/%d" whose numbers are read straight from the bound ints or floats.
+// Update polls the sources and formats into an inline buffer only when a value changed, with no String or
+// Stringf in between. Glyphs whose characters did not change keep their cached vertexes; a change in text
+// length lays the line out again. Placeholders are %d, %f (6 digits) and %.Nf; %% writes a percent sign.
+//
+// The label is passive: it keeps IWidget's GetHitBounds, so it is never hit-tested and never takes the cursor
+// from the widgets under it, however large its box.
+//
+// The sources must outlive the widget or be unbound first. Owners release the widget with MarkForDestroy in
+// their destructor, which takes it off the Update list straight away.
+//
+class NumericTextWidget : public IWidget
+{
+public:
+    NumericTextWidget(String const& format, int x, int y, int width, int height, Rgba8 const& color);
+
+    void Draw() const override;
+    bool AppendToBatch(WidgetRenderBatcher& batcher) const override;
+    void ApplyLayout(AABB2 const& bounds) override;
+    void Update() override;
+
+    /// Binds the next unbound placeholder, in the order they appear in the format
+    void BindValue(int const* source);
+    void BindValue(float const* source);
+    void ClearBindings();
+
+    char const* GetText() const;
+    void        SetPosition(Vec2 const& newPosition);
+    void        SetDimensions(Vec2 const& newDimensions);
+    void        SetColor(Rgba8 const& color);
+
+    /// Counters shared by every NumericTextWidget, the frame counts are reset by WidgetSubsystem::BeginFrame
+    static WidgetStats<eNumericTextStat> const& GetNumericTextStats();
+
+private:
+    void ParseFormat();
+    bool PollBoundValues();
+    void FormatText();
+    void UpdateTextVerts() const;
+    void RebuildTextVerts() const;
+    bool WriteGlyphVerts(int glyphIndex) const;
+    Vec2 GetGlyphMins(int glyphIndex) const;
+
+    String              m_format;
+    sNumericTextBinding m_bindings[NUMERIC_TEXT_MAX_BINDINGS];
+    int                 m_placeholderCount = 0;
+    int                 m_boundCount       = 0;
+    char                m_text[NUMERIC_TEXT_CAPACITY];     // Null-terminated
+    int                 m_textLength       = 0;
+    int                 m_x, m_y, m_width, m_height;
+    Rgba8               m_color;
+    float               m_cellHeight       = 20.f;
+
+    // Glyphs laid out right-aligned at (m_cachedX, m_cachedY), m_glyphVertexCount vertexes per character.
+    // Bit i of m_changedGlyphMask marks a character FormatText changed without changing the text length.
+    mutable VertexList_PCU m_textVerts;
+    mutable VertexList_PCU m_glyphScratch;
+    mutable String         m_glyphString;
+    mutable int            m_glyphVertexCount = 0;
+    mutable uint64_t       m_changedGlyphMask = 0;
+    mutable int            m_cachedX          = 0;
+    mutable int            m_cachedY          = 0;
+
+    static WidgetStats<eNumericTextStat> s_numericTextStats;
+};
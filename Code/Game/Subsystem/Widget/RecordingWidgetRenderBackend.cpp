@@ -0,0 +1,88 @@
+//----------------------------------------------------------------------------------------------------
+// RecordingWidgetRenderBackend.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Widget/RecordingWidgetRenderBackend.hpp"
+
+//----------------------------------------------------------------------------------------------------
+void RecordingWidgetRenderBackend::BeginWidgetPass()
+{
+    ++m_passCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingWidgetRenderBackend::SetBlendMode(eBlendMode const blendMode)
+{
+    m_boundBlendMode = blendMode;
+    ++m_blendModeChangeCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingWidgetRenderBackend::BindTexture(Texture const* texture)
+{
+    m_boundTexture = texture;
+    ++m_textureBindCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingWidgetRenderBackend::DrawVertexArray(int const vertexCount, Vertex_PCU const* vertexes)
+{
+    sRecordedWidgetDraw draw;
+    draw.m_texture     = m_boundTexture;
+    draw.m_blendMode   = m_boundBlendMode;
+    draw.m_vertexCount = vertexCount;
+    m_draws.push_back(draw);
+
+    m_vertexes.insert(m_vertexes.end(), vertexes, vertexes + vertexCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingWidgetRenderBackend::DrawUnbatchedWidget(IWidget const& widget)
+{
+    sRecordedWidgetDraw draw;
+    draw.m_widget = &widget;
+    m_draws.push_back(draw);
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<sRecordedWidgetDraw> const& RecordingWidgetRenderBackend::GetRecordedDraws() const
+{
+    return m_draws;
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<Vertex_PCU> const& RecordingWidgetRenderBackend::GetRecordedVertexes() const
+{
+    return m_vertexes;
+}
+
+//----------------------------------------------------------------------------------------------------
+int RecordingWidgetRenderBackend::GetPassCount() const
+{
+    return m_passCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+int RecordingWidgetRenderBackend::GetTextureBindCount() const
+{
+    return m_textureBindCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+int RecordingWidgetRenderBackend::GetBlendModeChangeCount() const
+{
+    return m_blendModeChangeCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RecordingWidgetRenderBackend::Clear()
+{
+    m_draws.clear();
+    m_vertexes.clear();
+    m_boundTexture         = nullptr;
+    m_boundBlendMode       = eBlendMode::ALPHA;
+    m_passCount            = 0;
+    m_textureBindCount     = 0;
+    m_blendModeChangeCount = 0;
+}
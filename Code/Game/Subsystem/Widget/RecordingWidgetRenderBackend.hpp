@@ -0,0 +1,48 @@
+//----------------------------------------------------------------------------------------------------
+// RecordingWidgetRenderBackend.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <vector>
+
+#include "Game/Subsystem/Widget/IWidgetRenderBackend.hpp"
+
+//----------------------------------------------------------------------------------------------------
+struct sRecordedWidgetDraw
+{
+    Texture const* m_texture     = nullptr;
+    eBlendMode     m_blendMode   = eBlendMode::ALPHA;
+    int            m_vertexCount = 0;
+    IWidget const* m_widget      = nullptr;     // Set for unbatched widgets, which are recorded but not drawn
+};
+
+//----------------------------------------------------------------------------------------------------
+// Stand-in for the renderer: no device, no GPU. Records every draw with the texture and blend mode bound
+// at the time, so batching can be checked off Windows. Texture pointers are only compared, never used.
+//
+class RecordingWidgetRenderBackend : public IWidgetRenderBackend
+{
+public:
+    void BeginWidgetPass() override;
+    void SetBlendMode(eBlendMode blendMode) override;
+    void BindTexture(Texture const* texture) override;
+    void DrawVertexArray(int vertexCount, Vertex_PCU const* vertexes) override;
+    void DrawUnbatchedWidget(IWidget const& widget) override;
+
+    std::vector<sRecordedWidgetDraw> const& GetRecordedDraws() const;
+    std::vector<Vertex_PCU> const&          GetRecordedVertexes() const;
+    int                                     GetPassCount() const;
+    int                                     GetTextureBindCount() const;
+    int                                     GetBlendModeChangeCount() const;
+    void                                    Clear();
+
+private:
+    std::vector<sRecordedWidgetDraw> m_draws;
+    std::vector<Vertex_PCU>          m_vertexes;                  // Every batched vertex, in draw order
+    Texture const*                   m_boundTexture         = nullptr;
+    eBlendMode                       m_boundBlendMode       = eBlendMode::ALPHA;
+    int                              m_passCount            = 0;
+    int                              m_textureBindCount     = 0;
+    int                              m_blendModeChangeCount = 0;
+};
@@ -0,0 +1,44 @@
+//----------------------------------------------------------------------------------------------------
+// RendererWidgetRenderBackend.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Widget/RendererWidgetRenderBackend.hpp"
+
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Subsystem/Widget/IWidget.hpp"
+
+//----------------------------------------------------------------------------------------------------
+void RendererWidgetRenderBackend::BeginWidgetPass()
+{
+    // Entity 的 Render 會留下各自的狀態（例如 Shop 的半透明 tint），Widget 統一從乾淨的狀態開始
+    g_theRenderer->SetModelConstants();
+    g_theRenderer->SetRasterizerMode(eRasterizerMode::SOLID_CULL_BACK);
+    g_theRenderer->SetSamplerMode(eSamplerMode::BILINEAR_CLAMP);
+    g_theRenderer->SetDepthMode(eDepthMode::DISABLED);
+    g_theRenderer->BindShader(g_theRenderer->CreateOrGetShaderFromFile("Data/Shaders/Default"));
+}
+
+//----------------------------------------------------------------------------------------------------
+void RendererWidgetRenderBackend::SetBlendMode(eBlendMode const blendMode)
+{
+    g_theRenderer->SetBlendMode(blendMode);
+}
+
+//----------------------------------------------------------------------------------------------------
+void RendererWidgetRenderBackend::BindTexture(Texture const* texture)
+{
+    g_theRenderer->BindTexture(texture);
+}
+
+//----------------------------------------------------------------------------------------------------
+void RendererWidgetRenderBackend::DrawVertexArray(int const vertexCount, Vertex_PCU const* vertexes)
+{
+    g_theRenderer->DrawVertexArray(vertexCount, vertexes);
+}
+
+//----------------------------------------------------------------------------------------------------
+void RendererWidgetRenderBackend::DrawUnbatchedWidget(IWidget const& widget)
+{
+    widget.Draw();
+}
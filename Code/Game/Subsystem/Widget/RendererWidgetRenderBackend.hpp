@@ -0,0 +1,20 @@
+//----------------------------------------------------------------------------------------------------
+// RendererWidgetRenderBackend.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Game/Subsystem/Widget/IWidgetRenderBackend.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Forwards widget batches to g_theRenderer.
+//
+class RendererWidgetRenderBackend : public IWidgetRenderBackend
+{
+public:
+    void BeginWidgetPass() override;
+    void SetBlendMode(eBlendMode blendMode) override;
+    void BindTexture(Texture const* texture) override;
+    void DrawVertexArray(int vertexCount, Vertex_PCU const* vertexes) override;
+    void DrawUnbatchedWidget(IWidget const& widget) override;
+};
@@ -0,0 +1,44 @@
+//----------------------------------------------------------------------------------------------------
+// WidgetLayout.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Widget/WidgetLayout.hpp"
+
+#include "Engine/Core/EngineCommon.hpp"
+
+//----------------------------------------------------------------------------------------------------
+STATIC sWidgetAnchor sWidgetAnchor::MakeWindowAnchor(WindowID const windowID, Vec2 const& offset)
+{
+    sWidgetAnchor anchor;
+    anchor.m_target   = eWidgetAnchorTarget::WINDOW;
+    anchor.m_windowID = windowID;
+    anchor.m_offset   = offset;
+    return anchor;
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC sWidgetAnchor sWidgetAnchor::MakeEntityAnchor(EntityID const entityID, Vec2 const& offset)
+{
+    sWidgetAnchor anchor;
+    anchor.m_target   = eWidgetAnchorTarget::ENTITY;
+    anchor.m_entityID = entityID;
+    anchor.m_offset   = offset;
+    return anchor;
+}
+
+//----------------------------------------------------------------------------------------------------
+AABB2 ComputeWidgetLayoutBounds(sWidgetAnchor const& anchor, AABB2 const& clientRect)
+{
+    Vec2 const clientDimensions = clientRect.m_maxs - clientRect.m_mins;
+    Vec2 const anchorPoint      = clientRect.m_mins + Vec2(clientDimensions.x * anchor.m_anchor.x, clientDimensions.y * anchor.m_anchor.y);
+    Vec2 const mins             = anchorPoint + anchor.m_offset;
+
+    Vec2 dimensions = anchor.m_size;
+    if (anchor.m_sizeRule == eWidgetSizeRule::RELATIVE_TO_CLIENT)
+    {
+        dimensions = Vec2(clientDimensions.x * anchor.m_size.x, clientDimensions.y * anchor.m_size.y);
+    }
+
+    return AABB2(mins, mins + dimensions);
+}
@@ -0,0 +1,54 @@
+//----------------------------------------------------------------------------------------------------
+// WidgetLayout.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Game/Framework/GameCommon.hpp"
+
+//----------------------------------------------------------------------------------------------------
+enum class eWidgetAnchorTarget : uint8_t
+{
+    WINDOW,     // m_windowID's client rect
+    ENTITY      // Client rect of the window m_entityID is mapped to, looked up every pass
+};
+
+//----------------------------------------------------------------------------------------------------
+enum class eWidgetSizeRule : uint8_t
+{
+    FIXED,                  // m_size in pixels
+    RELATIVE_TO_CLIENT      // m_size as a fraction of the anchor's client dimensions
+};
+
+//----------------------------------------------------------------------------------------------------
+// Where a widget sits relative to a window client rect. The widget's bottom-left corner is placed at
+// the normalised m_anchor point of the client rect (0,0 is bottom-left, 1,1 is top-right) plus m_offset.
+struct sWidgetAnchor
+{
+    eWidgetAnchorTarget m_target   = eWidgetAnchorTarget::WINDOW;
+    WindowID            m_windowID = 0;
+    EntityID            m_entityID = 0;
+    Vec2                m_anchor   = Vec2::ZERO;
+    Vec2                m_offset   = Vec2::ZERO;
+    eWidgetSizeRule     m_sizeRule = eWidgetSizeRule::RELATIVE_TO_CLIENT;
+    Vec2                m_size     = Vec2::ONE;
+
+    static sWidgetAnchor MakeWindowAnchor(WindowID windowID, Vec2 const& offset = Vec2::ZERO);
+    static sWidgetAnchor MakeEntityAnchor(EntityID entityID, Vec2 const& offset = Vec2::ZERO);
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sWidgetLayoutStats
+{
+    uint32_t m_boundCount         = 0;     // Widgets with an anchor
+    uint32_t m_frameResolvedCount = 0;     // Anchors whose target changed and were laid out again this frame
+    uint32_t m_frameSkippedCount  = 0;     // Anchors whose target geometry had the same revision
+    uint32_t m_frameMissingCount  = 0;     // Anchors whose window or entity does not exist (yet)
+};
+
+//----------------------------------------------------------------------------------------------------
+AABB2 ComputeWidgetLayoutBounds(sWidgetAnchor const& anchor, AABB2 const& clientRect);
@@ -0,0 +1,108 @@
+//----------------------------------------------------------------------------------------------------
+// WidgetRenderBatcher.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Widget/WidgetRenderBatcher.hpp"
+
+//----------------------------------------------------------------------------------------------------
+WidgetRenderBatcher::WidgetRenderBatcher(size_t const initialVertexCapacity)
+{
+    m_vertexes.reserve(initialVertexCapacity);
+    m_batches.reserve(16);
+}
+
+//----------------------------------------------------------------------------------------------------
+void WidgetRenderBatcher::BeginBatch()
+{
+    // clear() 保留容量，穩定狀態下每幀不會重新配置
+    m_vertexes.clear();
+    m_batches.clear();
+    m_stats = sWidgetRenderStats{};
+}
+
+//----------------------------------------------------------------------------------------------------
+void WidgetRenderBatcher::AddVerts(VertexList_PCU const& verts,
+                                   Texture const*        texture,
+                                   eBlendMode const      blendMode)
+{
+    ++m_stats.m_batchedWidgetCount;
+    if (verts.empty()) return;
+
+    bool const canExtend = !m_batches.empty() &&
+                           m_batches.back().m_widget == nullptr &&
+                           m_batches.back().m_texture == texture &&
+                           m_batches.back().m_blendMode == blendMode;
+
+    if (!canExtend)
+    {
+        sWidgetDrawBatch batch;
+        batch.m_texture     = texture;
+        batch.m_blendMode   = blendMode;
+        batch.m_firstVertex = m_vertexes.size();
+        m_batches.push_back(batch);
+    }
+
+    m_vertexes.insert(m_vertexes.end(), verts.begin(), verts.end());
+    m_batches.back().m_vertexCount += verts.size();
+}
+
+//----------------------------------------------------------------------------------------------------
+void WidgetRenderBatcher::AddUnbatchedWidget(IWidget const& widget)
+{
+    ++m_stats.m_unbatchedWidgetCount;
+
+    sWidgetDrawBatch batch;
+    batch.m_widget = &widget;
+    m_batches.push_back(batch);
+}
+
+//----------------------------------------------------------------------------------------------------
+void WidgetRenderBatcher::Flush(IWidgetRenderBackend& backend)
+{
+    if (m_batches.empty()) return;
+
+    backend.BeginWidgetPass();
+
+    // 目前綁定的狀態未知，第一個 batch 一定要設定；unbatched widget 可能改掉任何狀態，之後也要重新設定
+    bool           isStateKnown   = false;
+    Texture const* boundTexture   = nullptr;
+    eBlendMode     boundBlendMode = eBlendMode::ALPHA;
+
+    for (sWidgetDrawBatch const& batch : m_batches)
+    {
+        if (batch.m_widget != nullptr)
+        {
+            backend.DrawUnbatchedWidget(*batch.m_widget);
+            ++m_stats.m_drawCallCount;
+            isStateKnown = false;
+            continue;
+        }
+
+        if (!isStateKnown || batch.m_blendMode != boundBlendMode)
+        {
+            backend.SetBlendMode(batch.m_blendMode);
+            boundBlendMode = batch.m_blendMode;
+            ++m_stats.m_blendModeChangeCount;
+        }
+
+        if (!isStateKnown || batch.m_texture != boundTexture)
+        {
+            backend.BindTexture(batch.m_texture);
+            boundTexture = batch.m_texture;
+            ++m_stats.m_textureBindCount;
+        }
+
+        isStateKnown = true;
+
+        backend.DrawVertexArray(static_cast<int>(batch.m_vertexCount), m_vertexes.data() + batch.m_firstVertex);
+        ++m_stats.m_drawCallCount;
+        m_stats.m_vertexCount += static_cast<uint32_t>(batch.m_vertexCount);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+sWidgetRenderStats const& WidgetRenderBatcher::GetStats() const
+{
+    return m_stats;
+}
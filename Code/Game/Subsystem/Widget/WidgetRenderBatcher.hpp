@@ -0,0 +1,54 @@
+//----------------------------------------------------------------------------------------------------
+// WidgetRenderBatcher.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Game/Subsystem/Widget/IWidgetRenderBackend.hpp"
+
+//----------------------------------------------------------------------------------------------------
+struct sWidgetDrawBatch
+{
+    Texture const* m_texture     = nullptr;
+    eBlendMode     m_blendMode   = eBlendMode::ALPHA;
+    size_t         m_firstVertex = 0;
+    size_t         m_vertexCount = 0;
+    IWidget const* m_widget      = nullptr;     // Set for an unbatched widget, which draws itself at this point
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sWidgetRenderStats
+{
+    uint32_t m_drawCallCount        = 0;     // Batched draws plus unbatched widgets
+    uint32_t m_vertexCount          = 0;     // Batched vertexes only
+    uint32_t m_batchedWidgetCount   = 0;
+    uint32_t m_unbatchedWidgetCount = 0;
+    uint32_t m_textureBindCount     = 0;
+    uint32_t m_blendModeChangeCount = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Collects the geometry of every visible widget, in the order they are added, into one shared vertex
+// buffer. Consecutive widgets with the same texture and blend mode extend the same batch, so a frame of
+// text widgets costs one draw. Widgets that cannot batch keep their place in the order and split the run.
+//
+class WidgetRenderBatcher
+{
+public:
+    explicit WidgetRenderBatcher(size_t initialVertexCapacity = 4096);
+
+    void BeginBatch();
+    void AddVerts(VertexList_PCU const& verts, Texture const* texture, eBlendMode blendMode);
+    void AddUnbatchedWidget(IWidget const& widget);
+    void Flush(IWidgetRenderBackend& backend);
+
+    sWidgetRenderStats const& GetStats() const;
+
+private:
+    VertexList_PCU                m_vertexes;
+    std::vector<sWidgetDrawBatch> m_batches;
+    sWidgetRenderStats            m_stats;
+};
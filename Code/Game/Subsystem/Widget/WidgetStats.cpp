@@ -0,0 +1,44 @@
+//----------------------------------------------------------------------------------------------------
+// WidgetStats.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Widget/WidgetStats.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "Engine/Core/EngineCommon.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Function-local so the registry exists before the first static WidgetStats registers, whatever the
+// translation unit initialization order.
+static std::vector<WidgetFrameCounters*>& GetRegisteredFrameCounters()
+{
+    static std::vector<WidgetFrameCounters*> s_registeredFrameCounters;
+    return s_registeredFrameCounters;
+}
+
+//----------------------------------------------------------------------------------------------------
+WidgetFrameCounters::WidgetFrameCounters(uint32_t* frameCounts, int const counterCount)
+    : m_frameCounts(frameCounts),
+      m_counterCount(counterCount)
+{
+    GetRegisteredFrameCounters().push_back(this);
+}
+
+//----------------------------------------------------------------------------------------------------
+WidgetFrameCounters::~WidgetFrameCounters()
+{
+    std::vector<WidgetFrameCounters*>& registered = GetRegisteredFrameCounters();
+    registered.erase(std::remove(registered.begin(), registered.end(), this), registered.end());
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC void WidgetFrameCounters::ResetAllFrameCounts()
+{
+    for (WidgetFrameCounters* frameCounters : GetRegisteredFrameCounters())
+    {
+        std::fill_n(frameCounters->m_frameCounts, frameCounters->m_counterCount, 0u);
+    }
+}
@@ -0,0 +1,76 @@
+//----------------------------------------------------------------------------------------------------
+// WidgetStats.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+
+//----------------------------------------------------------------------------------------------------
+// Every WidgetStats registers its frame counters here on construction, so WidgetSubsystem::BeginFrame can
+// clear the counters of every widget type without knowing which types exist.
+class WidgetFrameCounters
+{
+public:
+    static void ResetAllFrameCounts();
+
+    WidgetFrameCounters(WidgetFrameCounters const&)            = delete;
+    WidgetFrameCounters& operator=(WidgetFrameCounters const&) = delete;
+
+protected:
+    WidgetFrameCounters(uint32_t* frameCounts, int counterCount);
+    ~WidgetFrameCounters();
+
+private:
+    uint32_t* m_frameCounts  = nullptr;
+    int       m_counterCount = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Counters indexed by TStat, an enum class ending in COUNT. Each keeps a count for the current frame and a
+// total since start up. Widget types hold one as a static member and record into it from their caches.
+template <typename TStat>
+class WidgetStats : public WidgetFrameCounters
+{
+public:
+    static constexpr int STAT_COUNT = static_cast<int>(TStat::COUNT);
+
+    WidgetStats();
+
+    void     Increment(TStat stat);
+    uint32_t GetFrameCount(TStat stat) const;
+    uint64_t GetTotalCount(TStat stat) const;
+
+private:
+    uint32_t m_frameCounts[STAT_COUNT] = {};
+    uint64_t m_totalCounts[STAT_COUNT] = {};
+};
+
+//----------------------------------------------------------------------------------------------------
+template <typename TStat>
+WidgetStats<TStat>::WidgetStats()
+    : WidgetFrameCounters(m_frameCounts, STAT_COUNT)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename TStat>
+void WidgetStats<TStat>::Increment(TStat const stat)
+{
+    ++m_frameCounts[static_cast<int>(stat)];
+    ++m_totalCounts[static_cast<int>(stat)];
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename TStat>
+uint32_t WidgetStats<TStat>::GetFrameCount(TStat const stat) const
+{
+    return m_frameCounts[static_cast<int>(stat)];
+}
+
+//----------------------------------------------------------------------------------------------------
+template <typename TStat>
+uint64_t WidgetStats<TStat>::GetTotalCount(TStat const stat) const
+{
+    return m_totalCounts[static_cast<int>(stat)];
+}
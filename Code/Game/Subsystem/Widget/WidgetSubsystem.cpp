@@ -8,13 +8,33 @@
 #include <algorithm>
 
 #include "Game/Subsystem/Widget/IWidget.hpp"
+#include "Game/Subsystem/Widget/RendererWidgetRenderBackend.hpp"
+#include "Game/Subsystem/Window/WindowSubsystem.hpp"
+#include "Engine/Input/InputSystem.hpp"
+#include "Engine/Platform/Window.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static uint32_t GetSlotIndex(WidgetHandle const handle)
+{
+    return handle & WIDGET_HANDLE_INDEX_MASK;
+}
+
+//----------------------------------------------------------------------------------------------------
+static uint32_t GetGeneration(WidgetHandle const handle)
+{
+    return handle >> WIDGET_HANDLE_INDEX_BITS;
+}
 
 //----------------------------------------------------------------------------------------------------
 WidgetSubsystem::WidgetSubsystem(sWidgetSubsystemConfig const& config)
-    : m_config(config)
+    : m_config(config),
+      m_hitIndex(config.m_hitTestCellSize),
+      m_renderBatcher(config.m_initialBatchVertexCapacity)
 {
     m_widgets.reserve(m_config.m_initialWidgetCapacity);
-    m_ownerWidgetsMapping.reserve(m_config.m_initialOwnerCapacity);
+    m_denseWidgetHandles.reserve(m_config.m_initialWidgetCapacity);
+    m_widgetSlots.reserve(m_config.m_initialWidgetCapacity);
+    m_ownerFirstSlot.reserve(m_config.m_initialOwnerCapacity);
 }
 
 //----------------------------------------------------------------------------------------------------
@@ -25,239 +45,793 @@ WidgetSubsystem::~WidgetSubsystem()
 void WidgetSubsystem::StartUp()
 {
     // 清空所有容器
-    m_widgets.clear();
-    m_ownerWidgetsMapping.clear();
-    m_viewportWidget = nullptr;
-    m_bNeedsSorting  = false;
+    RemoveAllWidgets();
+    m_viewportWidget = 0;
+
+    m_renderBackend = m_config.m_renderBackend;
+    if (m_renderBackend == nullptr)
+    {
+        m_ownedRenderBackend = std::make_unique<RendererWidgetRenderBackend>();
+        m_renderBackend      = m_ownedRenderBackend.get();
+    }
 }
 
 void WidgetSubsystem::BeginFrame()
 {
-    // 對所有 Widget 呼叫 BeginFrame
-    for (auto& widget : m_widgets)
+    WidgetFrameCounters::ResetAllFrameCounts();
+    m_poolStats.m_frameSweptCount = 0;
+
+    // 只對需要 BeginFrame 的 Widget 呼叫，其他 Widget 完全不會被走訪
+    m_isWalkingWidgets = true;
+    for (size_t index = 0; index < m_frameHookWidgets.size(); ++index)
     {
-        if (widget && !widget->IsGarbage())
-        {
-            widget->BeginFrame();
-        }
+        GetWidget(m_frameHookWidgets[index])->BeginFrame();
     }
+    m_isWalkingWidgets = false;
+    ApplyQueuedListRefreshes();
 }
 
 void WidgetSubsystem::Update()
 {
-    // 清理垃圾 Widget
-    CleanupGarbageWidgets();
+    // 清理垃圾 Widget：只有在有 Widget 被標記時才需要
+    if (!m_pendingDestroyHandles.empty())
+    {
+        CleanupGarbageWidgets();
+    }
 
-    // 如果需要，重新排序
-    if (m_bNeedsSorting)
+    // 不需要排序：Layer 本身就是依 Z-Order 排好的，只要把累積的過期項目清掉
+    if (m_hasStaleLayerEntries)
     {
-        SortWidgetsByZOrder();
-        m_bNeedsSorting = false;
+        CompactWidgetLayers();
     }
 
-    // 更新所有需要 Tick 的 Widget
-    for (auto& widget : m_widgets)
+    // 視窗這一幀的幾何已經拍好快照，一次把幾何有變動的 anchor 重新排版
+    ResolveWidgetLayouts();
+
+    // 排版後位置確定，只重新索引有變動的 Widget，再把游標事件送給最上層的那一個
+    UpdateWidgetHitIndex();
+    if (m_config.m_isCursorInputEnabled && Window::s_mainWindow != nullptr && g_theInput != nullptr)
     {
-        if (widget && widget->IsTick() && !widget->IsGarbage())
-        {
-            widget->Update();
-        }
+        ProcessCursor(Window::s_mainWindow->GetCursorPositionOnScreen(), g_theInput->WasKeyJustPressed(KEYCODE_LEFT_MOUSE));
     }
+
+    // 只更新 Tick 串列裡的 Widget；Update 中對串列的變更先排隊，走訪結束後才套用
+    m_isWalkingWidgets = true;
+    for (size_t index = 0; index < m_tickWidgets.size(); ++index)
+    {
+        GetWidget(m_tickWidgets[index])->Update();
+    }
+    m_isWalkingWidgets = false;
+    ApplyQueuedListRefreshes();
 }
 
 void WidgetSubsystem::Render() const
 {
-    // 按照 Z-Order 渲染所有 Widget
-    for (auto& widget : m_widgets)
+    // 按照 Z-Order 收集所有 Widget 的頂點，貼圖或混合模式相同的連續 Widget 合併成一次 draw；
+    // Layer 裡只有可見的 Widget，不需要再逐一檢查
+    m_renderBatcher.BeginBatch();
+    for (sWidgetLayer const& layer : m_layers)
     {
-        if (widget && widget->IsVisible() && !widget->IsGarbage())
+        for (sWidgetLayerEntry const& entry : layer.m_entries)
         {
-            widget->Render();
+            IWidget const* widget = ResolveLayerEntry(entry);
+            if (widget && !widget->AppendToBatch(m_renderBatcher))
+            {
+                m_renderBatcher.AddUnbatchedWidget(*widget);
+            }
         }
     }
+
+    if (m_renderBackend == nullptr) return;
+    m_renderBatcher.Flush(*m_renderBackend);
 }
 
 void WidgetSubsystem::EndFrame()
 {
-    // 對所有 Widget 呼叫 EndFrame
-    for (auto& widget : m_widgets)
+    // 只對需要 EndFrame 的 Widget 呼叫
+    m_isWalkingWidgets = true;
+    for (size_t index = 0; index < m_frameHookWidgets.size(); ++index)
     {
-        if (widget && !widget->IsGarbage())
-        {
-            widget->EndFrame();
-        }
+        GetWidget(m_frameHookWidgets[index])->EndFrame();
     }
+    m_isWalkingWidgets = false;
+    ApplyQueuedListRefreshes();
 }
 
 void WidgetSubsystem::ShutDown()
 {
     RemoveAllWidgets();
-    m_viewportWidget = nullptr;
+    m_viewportWidget = 0;
+    m_renderBackend  = nullptr;
+    m_ownedRenderBackend.reset();
 }
 
-void WidgetSubsystem::AddWidget(WidgetPtr const& widget,
-                                int const        zOrder)
+void WidgetSubsystem::AddWidget(IWidget*  widget,
+                                int const zOrder)
 {
-    if (!widget) return;
+    if (!widget || FindDenseIndex(widget->GetHandle()) == INVALID_WIDGET_INDEX) return;
 
+    // 已經在 Layer 中的 Widget 由 SetZOrder 搬到新的 Layer
     widget->SetZOrder(zOrder);
-    m_widgets.push_back(widget);
-    m_bNeedsSorting = true;
+
+    m_widgetSlots[GetSlotIndex(widget->GetHandle())].m_isAdded = true;
+    RefreshWidgetLists(widget->GetHandle());
 }
 
-void WidgetSubsystem::AddWidgetToEntity(WidgetPtr const& widget,
-                                        void*            entity,
-                                        int const        zOrder)
+void WidgetSubsystem::AddWidgetToEntity(IWidget*  widget,
+                                        void*     entity,
+                                        int const zOrder)
 {
-    if (!widget || !entity) return;
+    if (!widget || !entity || FindDenseIndex(widget->GetHandle()) == INVALID_WIDGET_INDEX) return;
 
     widget->SetOwner(entity);
     widget->SetZOrder(zOrder);
 
-    m_widgets.push_back(widget);
-    m_ownerWidgetsMapping[entity].push_back(widget);
-    m_bNeedsSorting = true;
+    uint32_t const slotIndex = GetSlotIndex(widget->GetHandle());
+    LinkOwnedWidget(slotIndex, entity);
+    m_widgetSlots[slotIndex].m_isAdded = true;
+    RefreshWidgetLists(widget->GetHandle());
 }
 
-void WidgetSubsystem::RemoveWidget(WidgetPtr const& widget)
+void WidgetSubsystem::RemoveWidget(IWidget* widget)
 {
     if (!widget) return;
 
-    // 從主要列表中移除
-    auto it = std::find(m_widgets.begin(), m_widgets.end(), widget);
-    if (it != m_widgets.end())
+    // 延後到下一次 Update 才真正釋放，呼叫端這一幀手上的指標仍然有效
+    widget->MarkForDestroy();
+}
+
+void WidgetSubsystem::RemoveAllWidgetsFromEntity(void* entity)
+{
+    if (!entity) return;
+
+    auto const it = m_ownerFirstSlot.find(entity);
+    if (it == m_ownerFirstSlot.end()) return;
+
+    // 沿著 intrusive list 標記這個 Entity 的所有 Widget，不需要掃描整個 pool
+    for (uint32_t slotIndex = it->second; slotIndex != INVALID_WIDGET_INDEX; slotIndex = m_widgetSlots[slotIndex].m_nextOwnedSlot)
     {
-        m_widgets.erase(it);
+        m_widgets[m_widgetSlots[slotIndex].m_denseIndex]->MarkForDestroy();
     }
+}
 
-    // 從 Entity 映射中移除
-    void* owner = widget->GetOwner();
-    if (owner && m_ownerWidgetsMapping.find(owner) != m_ownerWidgetsMapping.end())
+void WidgetSubsystem::RemoveAllWidgets()
+{
+    m_widgets.clear();
+    m_denseWidgetHandles.clear();
+    m_widgetSlots.clear();
+    m_freeWidgetSlots.clear();
+    m_ownerFirstSlot.clear();
+    m_layers.clear();
+    m_hasStaleLayerEntries = false;
+    m_tickWidgets.clear();
+    m_frameHookWidgets.clear();
+    m_listRefreshQueue.clear();
+    m_layouts.clear();
+    m_layoutStats = sWidgetLayoutStats{};
+    m_hitIndex.Clear();
+    m_hitBoundsQueue.clear();
+    m_hoveredWidget = 0;
+    m_pendingDestroyHandles.clear();
+    m_poolStats.m_liveCount      = 0;
+    m_poolStats.m_layerCount     = 0;
+    m_poolStats.m_layeredCount   = 0;
+    m_poolStats.m_tickCount      = 0;
+    m_poolStats.m_frameHookCount = 0;
+}
+
+IWidget* WidgetSubsystem::GetWidget(WidgetHandle const handle) const
+{
+    uint32_t const denseIndex = FindDenseIndex(handle);
+    return denseIndex != INVALID_WIDGET_INDEX ? m_widgets[denseIndex].get() : nullptr;
+}
+
+IWidget* WidgetSubsystem::FindWidgetByName(String const& name) const
+{
+    for (auto& widget : m_widgets)
     {
-        auto& entityWidgets = m_ownerWidgetsMapping[owner];
-        auto  entityIt      = std::find(entityWidgets.begin(), entityWidgets.end(), widget);
-        if (entityIt != entityWidgets.end())
+        if (widget->GetName() == name)
         {
-            entityWidgets.erase(entityIt);
+            return widget.get();
         }
+    }
+    return nullptr;
+}
 
-        // 如果這個 Entity 沒有 Widget 了，移除整個條目
-        if (entityWidgets.empty())
-        {
-            m_ownerWidgetsMapping.erase(owner);
-        }
+std::vector<IWidget*> WidgetSubsystem::GetWidgetsByOwner(void* owner) const
+{
+    std::vector<IWidget*> ownedWidgets;
+
+    auto const it = m_ownerFirstSlot.find(owner);
+    if (it == m_ownerFirstSlot.end()) return ownedWidgets;
+
+    for (uint32_t slotIndex = it->second; slotIndex != INVALID_WIDGET_INDEX; slotIndex = m_widgetSlots[slotIndex].m_nextOwnedSlot)
+    {
+        ownedWidgets.push_back(m_widgets[m_widgetSlots[slotIndex].m_denseIndex].get());
     }
+
+    return ownedWidgets;
 }
 
-void WidgetSubsystem::RemoveAllWidgetsFromEntity(void* entity)
+std::vector<IWidget*> WidgetSubsystem::GetAllWidgets() const
 {
-    if (!entity) return;
+    std::vector<IWidget*> allWidgets;
+    allWidgets.reserve(m_widgets.size());
+
+    for (auto& widget : m_widgets)
+    {
+        allWidgets.push_back(widget.get());
+    }
+
+    return allWidgets;
+}
+
+sWidgetPoolStats WidgetSubsystem::GetPoolStats() const
+{
+    return m_poolStats;
+}
+
+void WidgetSubsystem::SetViewportWidget(IWidget* widget)
+{
+    m_viewportWidget = widget != nullptr ? widget->GetHandle() : 0;
+}
+
+IWidget* WidgetSubsystem::GetViewportWidget() const
+{
+    return GetWidget(m_viewportWidget);
+}
+
+void WidgetSubsystem::SetWidgetAnchor(IWidget* widget, sWidgetAnchor const& anchor)
+{
+    if (!widget || FindDenseIndex(widget->GetHandle()) == INVALID_WIDGET_INDEX) return;
+
+    sWidgetSlot& slot = m_widgetSlots[GetSlotIndex(widget->GetHandle())];
+    if (slot.m_layoutIndex == INVALID_WIDGET_INDEX)
+    {
+        slot.m_layoutIndex = static_cast<uint32_t>(m_layouts.size());
+        m_layouts.emplace_back();
+        m_layouts.back().m_handle = widget->GetHandle();
+    }
+
+    sWidgetLayout& layout = m_layouts[slot.m_layoutIndex];
+    layout.m_anchor       = anchor;
+    layout.m_isDirty      = true;
+
+    m_layoutStats.m_boundCount = static_cast<uint32_t>(m_layouts.size());
+}
+
+void WidgetSubsystem::ClearWidgetAnchor(IWidget* widget)
+{
+    if (!widget || FindDenseIndex(widget->GetHandle()) == INVALID_WIDGET_INDEX) return;
+
+    RemoveWidgetLayout(GetSlotIndex(widget->GetHandle()));
+}
+
+sWidgetLayoutStats const& WidgetSubsystem::GetLayoutStats() const
+{
+    return m_layoutStats;
+}
+
+sWidgetRenderStats const& WidgetSubsystem::GetRenderStats() const
+{
+    return m_renderBatcher.GetStats();
+}
+
+IWidgetRenderBackend* WidgetSubsystem::GetRenderBackend() const
+{
+    return m_renderBackend;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Widget pool：handle 經由 slot 找到 m_widgets 的索引，世代不符代表 handle 已過期
+//----------------------------------------------------------------------------------------------------
+
+WidgetHandle WidgetSubsystem::AdoptWidget(std::unique_ptr<IWidget> widget)
+{
+    uint32_t slotIndex;
+
+    if (!m_freeWidgetSlots.empty())
+    {
+        slotIndex = m_freeWidgetSlots.back();
+        m_freeWidgetSlots.pop_back();
+    }
+    else
+    {
+        if (m_widgetSlots.size() > WIDGET_HANDLE_INDEX_MASK) return 0;
+
+        slotIndex = static_cast<uint32_t>(m_widgetSlots.size());
+        m_widgetSlots.emplace_back();
+    }
+
+    sWidgetSlot&       slot   = m_widgetSlots[slotIndex];
+    WidgetHandle const handle = (slot.m_generation << WIDGET_HANDLE_INDEX_BITS) | slotIndex;
+    slot.m_denseIndex         = static_cast<uint32_t>(m_widgets.size());
+
+    widget->m_subsystem = this;
+    widget->m_handle    = handle;
+    m_widgets.push_back(std::move(widget));
+    m_denseWidgetHandles.push_back(handle);
+
+    ++m_poolStats.m_createCount;
+    m_poolStats.m_liveCount = m_widgets.size();
+
+    return handle;
+}
+
+void WidgetSubsystem::QueueWidgetDestroy(WidgetHandle const handle)
+{
+    if (FindDenseIndex(handle) == INVALID_WIDGET_INDEX) return;
+
+    m_pendingDestroyHandles.push_back(handle);
+}
+
+void WidgetSubsystem::DestroyWidget(WidgetHandle const handle)
+{
+    uint32_t const denseIndex = FindDenseIndex(handle);
+    if (denseIndex == INVALID_WIDGET_INDEX) return;
+
+    uint32_t const slotIndex = GetSlotIndex(handle);
+    UnlinkOwnedWidget(slotIndex);
+    RemoveWidgetFromLayer(slotIndex);
+    SetWidgetListMembership(m_tickWidgets, &sWidgetSlot::m_tickIndex, slotIndex, false);
+    SetWidgetListMembership(m_frameHookWidgets, &sWidgetSlot::m_frameHookIndex, slotIndex, false);
+    RemoveWidgetLayout(slotIndex);
+    m_hitIndex.Remove(handle);
+    if (m_hoveredWidget == handle) m_hoveredWidget = 0;
+
+    // Swap-remove: the last widget moves into the hole and its slot is pointed at the new index.
+    uint32_t const lastIndex = static_cast<uint32_t>(m_widgets.size() - 1);
+    if (denseIndex != lastIndex)
+    {
+        m_widgets[denseIndex]            = std::move(m_widgets[lastIndex]);
+        m_denseWidgetHandles[denseIndex] = m_denseWidgetHandles[lastIndex];
+        m_widgetSlots[GetSlotIndex(m_denseWidgetHandles[denseIndex])].m_denseIndex = denseIndex;
+    }
+    m_widgets.pop_back();
+    m_denseWidgetHandles.pop_back();
+
+    sWidgetSlot& slot   = m_widgetSlots[slotIndex];
+    slot.m_denseIndex   = INVALID_WIDGET_INDEX;
+    slot.m_isAdded      = false;
+    slot.m_isListQueued = false;
+    slot.m_generation   = (slot.m_generation + 1) & WIDGET_HANDLE_GENERATION_MASK;
+    if (slot.m_generation == 0) slot.m_generation = 1;
+    m_freeWidgetSlots.push_back(slotIndex);
+
+    if (m_viewportWidget == handle) m_viewportWidget = 0;
+
+    ++m_poolStats.m_destroyCount;
+    m_poolStats.m_liveCount = m_widgets.size();
+}
+
+uint32_t WidgetSubsystem::FindDenseIndex(WidgetHandle const handle) const
+{
+    uint32_t const slotIndex = GetSlotIndex(handle);
+    if (handle == 0 || slotIndex >= m_widgetSlots.size()) return INVALID_WIDGET_INDEX;
+
+    sWidgetSlot const& slot = m_widgetSlots[slotIndex];
+    return slot.m_generation == GetGeneration(handle) ? slot.m_denseIndex : INVALID_WIDGET_INDEX;
+}
+
+void WidgetSubsystem::LinkOwnedWidget(uint32_t const slotIndex, void* owner)
+{
+    UnlinkOwnedWidget(slotIndex);
+
+    // 插在串列最前面，O(1)
+    sWidgetSlot& slot   = m_widgetSlots[slotIndex];
+    auto const   result = m_ownerFirstSlot.emplace(owner, slotIndex);
+    if (!result.second)
+    {
+        uint32_t const oldFirstSlot                 = result.first->second;
+        slot.m_nextOwnedSlot                        = oldFirstSlot;
+        m_widgetSlots[oldFirstSlot].m_prevOwnedSlot = slotIndex;
+        result.first->second                        = slotIndex;
+    }
+    slot.m_listOwner = owner;
+}
+
+void WidgetSubsystem::UnlinkOwnedWidget(uint32_t const slotIndex)
+{
+    sWidgetSlot& slot = m_widgetSlots[slotIndex];
+    if (slot.m_listOwner == nullptr) return;
+
+    if (slot.m_prevOwnedSlot != INVALID_WIDGET_INDEX)
+    {
+        m_widgetSlots[slot.m_prevOwnedSlot].m_nextOwnedSlot = slot.m_nextOwnedSlot;
+    }
+    else if (slot.m_nextOwnedSlot != INVALID_WIDGET_INDEX)
+    {
+        m_ownerFirstSlot[slot.m_listOwner] = slot.m_nextOwnedSlot;
+    }
+    else
+    {
+        // 這個 Owner 沒有 Widget 了，移除整個條目
+        m_ownerFirstSlot.erase(slot.m_listOwner);
+    }
 
-    auto it = m_ownerWidgetsMapping.find(entity);
-    if (it != m_ownerWidgetsMapping.end())
+    if (slot.m_nextOwnedSlot != INVALID_WIDGET_INDEX)
     {
-        // 從主要列表中移除所有屬於這個 Entity 的 Widget
-        for (auto& widget : it->second)
+        m_widgetSlots[slot.m_nextOwnedSlot].m_prevOwnedSlot = slot.m_prevOwnedSlot;
+    }
+
+    slot.m_listOwner     = nullptr;
+    slot.m_prevOwnedSlot = INVALID_WIDGET_INDEX;
+    slot.m_nextOwnedSlot = INVALID_WIDGET_INDEX;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Z-Order layers：依 Z-Order 排好的 Layer，新增只需二分搜尋加上 push_back
+//----------------------------------------------------------------------------------------------------
+
+void WidgetSubsystem::InsertWidgetIntoLayer(uint32_t const slotIndex, int const zOrder)
+{
+    auto layerIt = std::lower_bound(m_layers.begin(), m_layers.end(), zOrder,
+                                    [](sWidgetLayer const& layer, int const z) {
+                                        return layer.m_zOrder < z;
+                                    });
+    if (layerIt == m_layers.end() || layerIt->m_zOrder != zOrder)
+    {
+        sWidgetLayer newLayer;
+        newLayer.m_zOrder        = zOrder;
+        layerIt                  = m_layers.insert(layerIt, std::move(newLayer));
+        m_poolStats.m_layerCount = m_layers.size();
+    }
+
+    sWidgetSlot& slot = m_widgetSlots[slotIndex];
+    ++slot.m_layerSequence;
+    slot.m_isLayered   = true;
+    slot.m_layerZOrder = zOrder;
+    slot.m_layerOrder  = m_nextLayerOrder++;
+    ++m_poolStats.m_layeredCount;
+
+    sWidgetLayerEntry entry;
+    entry.m_handle        = m_denseWidgetHandles[slot.m_denseIndex];
+    entry.m_layerSequence = slot.m_layerSequence;
+    layerIt->m_entries.push_back(entry);
+
+    QueueWidgetHitBoundsUpdate(entry.m_handle);
+}
+
+void WidgetSubsystem::RemoveWidgetFromLayer(uint32_t const slotIndex)
+{
+    sWidgetSlot& slot = m_widgetSlots[slotIndex];
+    if (!slot.m_isLayered) return;
+
+    // 不搬動其他項目，只讓舊的項目過期，等 Update 開頭再一次壓縮
+    ++slot.m_layerSequence;
+    slot.m_isLayered = false;
+    --m_poolStats.m_layeredCount;
+
+    auto const layerIt = std::lower_bound(m_layers.begin(), m_layers.end(), slot.m_layerZOrder,
+                                          [](sWidgetLayer const& layer, int const z) {
+                                              return layer.m_zOrder < z;
+                                          });
+    if (layerIt != m_layers.end() && layerIt->m_zOrder == slot.m_layerZOrder)
+    {
+        ++layerIt->m_staleCount;
+        m_hasStaleLayerEntries = true;
+    }
+}
+
+void WidgetSubsystem::MoveWidgetToLayer(WidgetHandle const handle, int const zOrder)
+{
+    uint32_t const denseIndex = FindDenseIndex(handle);
+    if (denseIndex == INVALID_WIDGET_INDEX) return;
+
+    uint32_t const slotIndex = GetSlotIndex(handle);
+    if (!m_widgetSlots[slotIndex].m_isLayered || m_widgetSlots[slotIndex].m_layerZOrder == zOrder) return;
+
+    RemoveWidgetFromLayer(slotIndex);
+    InsertWidgetIntoLayer(slotIndex, zOrder);
+}
+
+IWidget* WidgetSubsystem::ResolveLayerEntry(sWidgetLayerEntry const& entry) const
+{
+    uint32_t const denseIndex = FindDenseIndex(entry.m_handle);
+    if (denseIndex == INVALID_WIDGET_INDEX) return nullptr;
+
+    sWidgetSlot const& slot = m_widgetSlots[GetSlotIndex(entry.m_handle)];
+    return slot.m_layerSequence == entry.m_layerSequence ? m_widgets[denseIndex].get() : nullptr;
+}
+
+void WidgetSubsystem::CompactWidgetLayers()
+{
+    // 過期項目超過一半才重建該 Layer，攤提後每次移除仍是 O(1)；空的 Layer 直接移除
+    for (sWidgetLayer& layer : m_layers)
+    {
+        if (layer.m_staleCount * 2 < layer.m_entries.size()) continue;
+
+        layer.m_entries.erase(
+            std::remove_if(layer.m_entries.begin(), layer.m_entries.end(),
+                           [this](sWidgetLayerEntry const& entry) {
+                               return ResolveLayerEntry(entry) == nullptr;
+                           }),
+            layer.m_entries.end());
+        layer.m_staleCount = 0;
+        ++m_poolStats.m_compactCount;
+    }
+
+    m_layers.erase(
+        std::remove_if(m_layers.begin(), m_layers.end(),
+                       [](sWidgetLayer const& layer) {
+                           return layer.m_entries.empty();
+                       }),
+        m_layers.end());
+
+    m_poolStats.m_layerCount = m_layers.size();
+    m_hasStaleLayerEntries   = false;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Frame lists：每個階段只走訪需要它的 Widget，旗標改變時才加入或離開
+//----------------------------------------------------------------------------------------------------
+
+void WidgetSubsystem::RefreshWidgetLists(WidgetHandle const handle)
+{
+    uint32_t const denseIndex = FindDenseIndex(handle);
+    if (denseIndex == INVALID_WIDGET_INDEX) return;
+
+    uint32_t const slotIndex = GetSlotIndex(handle);
+    sWidgetSlot&   slot      = m_widgetSlots[slotIndex];
+
+    // 正在走訪串列時不能搬動它，先排隊等這次走訪結束
+    if (m_isWalkingWidgets)
+    {
+        if (!slot.m_isListQueued)
         {
-            auto mainIt = std::find(m_widgets.begin(), m_widgets.end(), widget);
-            if (mainIt != m_widgets.end())
-            {
-                m_widgets.erase(mainIt);
-            }
+            slot.m_isListQueued = true;
+            m_listRefreshQueue.push_back(handle);
         }
+        return;
+    }
+
+    IWidget const* widget = m_widgets[denseIndex].get();
+    bool const     isLive = slot.m_isAdded && !widget->IsGarbage();
 
-        // 從 Entity 映射中移除
-        m_ownerWidgetsMapping.erase(it);
+    bool const shouldBeLayered = isLive && widget->IsVisible();
+    if (shouldBeLayered && !slot.m_isLayered)
+    {
+        // 重新顯示的 Widget 接在同一層的最上面
+        InsertWidgetIntoLayer(slotIndex, widget->GetZOrder());
+    }
+    else if (!shouldBeLayered && slot.m_isLayered)
+    {
+        RemoveWidgetFromLayer(slotIndex);
     }
+
+    SetWidgetListMembership(m_tickWidgets, &sWidgetSlot::m_tickIndex, slotIndex, isLive && widget->IsTick());
+    SetWidgetListMembership(m_frameHookWidgets, &sWidgetSlot::m_frameHookIndex, slotIndex, isLive && widget->WantsFrameHooks());
 }
 
-void WidgetSubsystem::RemoveAllWidgets()
+void WidgetSubsystem::ApplyQueuedListRefreshes()
 {
-    m_widgets.clear();
-    m_ownerWidgetsMapping.clear();
+    if (m_listRefreshQueue.empty()) return;
+
+    for (WidgetHandle const handle : m_listRefreshQueue)
+    {
+        if (FindDenseIndex(handle) == INVALID_WIDGET_INDEX) continue;
+
+        m_widgetSlots[GetSlotIndex(handle)].m_isListQueued = false;
+        RefreshWidgetLists(handle);
+    }
+    m_listRefreshQueue.clear();
 }
 
-WidgetPtr WidgetSubsystem::FindWidgetByName(String const& name) const
+void WidgetSubsystem::SetWidgetListMembership(std::vector<WidgetHandle>& list,
+                                              uint32_t sWidgetSlot::*    listIndex,
+                                              uint32_t const             slotIndex,
+                                              bool const                 isMember)
 {
-    for (auto& widget : m_widgets)
+    uint32_t& index = m_widgetSlots[slotIndex].*listIndex;
+
+    if (isMember && index == INVALID_WIDGET_INDEX)
     {
-        if (widget && widget->GetName() == name)
+        index = static_cast<uint32_t>(list.size());
+        list.push_back(m_denseWidgetHandles[m_widgetSlots[slotIndex].m_denseIndex]);
+    }
+    else if (!isMember && index != INVALID_WIDGET_INDEX)
+    {
+        // Swap-remove：這些串列不在乎順序
+        uint32_t const lastIndex = static_cast<uint32_t>(list.size() - 1);
+        if (index != lastIndex)
         {
-            return widget;
+            list[index]                                         = list[lastIndex];
+            m_widgetSlots[GetSlotIndex(list[index])].*listIndex = index;
         }
+        list.pop_back();
+        index = INVALID_WIDGET_INDEX;
     }
-    return nullptr;
+
+    m_poolStats.m_tickCount      = m_tickWidgets.size();
+    m_poolStats.m_frameHookCount = m_frameHookWidgets.size();
 }
 
-std::vector<WidgetPtr> WidgetSubsystem::GetWidgetsByOwner(void* owner) const
+//----------------------------------------------------------------------------------------------------
+// Layout：anchor 只在目標視窗的幾何 revision 改變時才重新計算
+//----------------------------------------------------------------------------------------------------
+
+void WidgetSubsystem::RemoveWidgetLayout(uint32_t const slotIndex)
 {
-    auto const it = m_ownerWidgetsMapping.find(owner);
+    uint32_t const layoutIndex = m_widgetSlots[slotIndex].m_layoutIndex;
+    if (layoutIndex == INVALID_WIDGET_INDEX) return;
 
-    if (it != m_ownerWidgetsMapping.end())
+    uint32_t const lastIndex = static_cast<uint32_t>(m_layouts.size() - 1);
+    if (layoutIndex != lastIndex)
     {
-        return it->second;
+        m_layouts[layoutIndex] = m_layouts[lastIndex];
+        m_widgetSlots[GetSlotIndex(m_layouts[layoutIndex].m_handle)].m_layoutIndex = layoutIndex;
     }
+    m_layouts.pop_back();
+
+    m_widgetSlots[slotIndex].m_layoutIndex = INVALID_WIDGET_INDEX;
+    m_layoutStats.m_boundCount             = static_cast<uint32_t>(m_layouts.size());
+}
+
+void WidgetSubsystem::ResolveWidgetLayouts()
+{
+    m_layoutStats.m_frameResolvedCount = 0;
+    m_layoutStats.m_frameSkippedCount  = 0;
+    m_layoutStats.m_frameMissingCount  = 0;
+
+    if (g_theWindowSubsystem == nullptr) return;
+
+    for (sWidgetLayout& layout : m_layouts)
+    {
+        sWidgetAnchor const& anchor   = layout.m_anchor;
+        WindowID const       windowID = anchor.m_target == eWidgetAnchorTarget::ENTITY ? g_theWindowSubsystem->FindWindowIDByEntityID(anchor.m_entityID) : anchor.m_windowID;
 
-    return {};
+        sWindowGeometry const* geometry = g_theWindowSubsystem->GetWindowGeometry(windowID);
+        if (geometry == nullptr)
+        {
+            ++m_layoutStats.m_frameMissingCount;
+            continue;
+        }
+
+        if (!layout.m_isDirty && layout.m_resolvedWindowID == windowID && layout.m_geometryRevision == geometry->m_revision)
+        {
+            ++m_layoutStats.m_frameSkippedCount;
+            continue;
+        }
+
+        GetWidget(layout.m_handle)->ApplyLayout(ComputeWidgetLayoutBounds(anchor, geometry->m_clientRect));
+
+        layout.m_resolvedWindowID = windowID;
+        layout.m_geometryRevision = geometry->m_revision;
+        layout.m_isDirty          = false;
+        ++m_layoutStats.m_frameResolvedCount;
+    }
 }
 
-std::vector<WidgetPtr> WidgetSubsystem::GetAllWidgets() const
+//----------------------------------------------------------------------------------------------------
+// Hit test：格子索引可見 Widget 的範圍，查詢只測試游標所在格子裡的 Widget
+//----------------------------------------------------------------------------------------------------
+
+IWidget* WidgetSubsystem::PickWidgetAt(Vec2 const& point) const
 {
-    return m_widgets;
+    m_hitIndex.QueryPoint(point, m_hitScratch);
+    ++m_hitTestStats.m_queryCount;
+    m_hitTestStats.m_candidateCount += m_hitScratch.size();
+
+    // 候選通常只有一兩個：Z-Order 大的在上面，同一層裡較晚加入的在上面
+    IWidget* topWidget = nullptr;
+    int      topZOrder = 0;
+    uint32_t topOrder  = 0;
+    for (WindowID const handle : m_hitScratch)
+    {
+        IWidget* widget = GetWidget(handle);
+        if (widget == nullptr || widget->IsGarbage() || !widget->IsVisible()) continue;
+
+        sWidgetSlot const& slot = m_widgetSlots[GetSlotIndex(handle)];
+        if (topWidget == nullptr || slot.m_layerZOrder > topZOrder || (slot.m_layerZOrder == topZOrder && slot.m_layerOrder > topOrder))
+        {
+            topWidget = widget;
+            topZOrder = slot.m_layerZOrder;
+            topOrder  = slot.m_layerOrder;
+        }
+    }
+
+    return topWidget;
 }
 
-void WidgetSubsystem::SetViewportWidget(WidgetPtr const& widget)
+void WidgetSubsystem::ProcessCursor(Vec2 const& cursorPosition, bool const isClicked)
 {
-    m_viewportWidget = widget;
+    IWidget*           topWidget = PickWidgetAt(cursorPosition);
+    WidgetHandle const topHandle = topWidget != nullptr ? topWidget->GetHandle() : 0;
+
+    if (topHandle != m_hoveredWidget)
+    {
+        if (IWidget* previousWidget = GetWidget(m_hoveredWidget))
+        {
+            previousWidget->OnCursorLeave();
+            ++m_hitTestStats.m_leaveCount;
+        }
+
+        m_hoveredWidget = topHandle;
+
+        if (topWidget != nullptr)
+        {
+            topWidget->OnCursorEnter();
+            ++m_hitTestStats.m_enterCount;
+        }
+    }
+
+    if (topWidget == nullptr) return;
+
+    topWidget->OnCursorHover(cursorPosition);
+    if (isClicked)
+    {
+        topWidget->OnCursorClick(cursorPosition);
+        ++m_hitTestStats.m_clickCount;
+    }
 }
 
-WidgetPtr WidgetSubsystem::GetViewportWidget() const
+IWidget* WidgetSubsystem::GetHoveredWidget() const
 {
-    return m_viewportWidget;
+    return GetWidget(m_hoveredWidget);
 }
 
+sWidgetHitTestStats const& WidgetSubsystem::GetHitTestStats() const
+{
+    return m_hitTestStats;
+}
 
-void WidgetSubsystem::SortWidgetsByZOrder()
+void WidgetSubsystem::QueueWidgetHitBoundsUpdate(WidgetHandle const handle)
 {
-    if (m_widgets.empty()) return;
-    std::sort(m_widgets.begin(), m_widgets.end(),
-              [](const WidgetPtr& a, const WidgetPtr& b) {
-                  return a->GetZOrder() < b->GetZOrder();
-              });
+    if (FindDenseIndex(handle) == INVALID_WIDGET_INDEX) return;
+
+    sWidgetSlot& slot = m_widgetSlots[GetSlotIndex(handle)];
+    if (slot.m_isHitQueued) return;
+
+    slot.m_isHitQueued = true;
+    m_hitBoundsQueue.push_back(handle);
 }
 
-void WidgetSubsystem::CleanupGarbageWidgets()
+void WidgetSubsystem::UpdateWidgetHitIndex()
 {
-    // 移除標記為垃圾的 Widget
-    m_widgets.erase(
-        std::remove_if(m_widgets.begin(), m_widgets.end(),
-                       [](const WidgetPtr& widget) {
-                           return !widget || widget->IsGarbage();
-                       }),
-        m_widgets.end());
+    m_hitTestStats.m_frameBoundsUpdateCount = 0;
 
-    // 清理 Entity 映射中的垃圾 Widget
-    for (auto& pair : m_ownerWidgetsMapping)
+    for (WidgetHandle const queuedHandle : m_hitBoundsQueue)
     {
-        auto& widgets = pair.second;
-        widgets.erase(
-            std::remove_if(widgets.begin(), widgets.end(),
-                           [](const WidgetPtr& widget) {
-                               return !widget || widget->IsGarbage();
-                           }),
-            widgets.end());
-    }
+        // The only place the flag is cleared. A handle that died while queued was already removed from the index by
+        // DestroyWidget, but a widget that reused its slot found the flag set and relies on this entry to be indexed.
+        sWidgetSlot& slot  = m_widgetSlots[GetSlotIndex(queuedHandle)];
+        slot.m_isHitQueued = false;
+        if (slot.m_denseIndex == INVALID_WIDGET_INDEX) continue;
 
-    // 移除空的 Entity 條目
-    for (auto it = m_ownerWidgetsMapping.begin(); it != m_ownerWidgetsMapping.end();)
-    {
-        if (it->second.empty())
+        WidgetHandle const handle = m_denseWidgetHandles[slot.m_denseIndex];
+        IWidget*           widget = m_widgets[slot.m_denseIndex].get();
+
+        AABB2 bounds;
+        if (slot.m_isLayered && widget->GetHitBounds(bounds))
         {
-            it = m_ownerWidgetsMapping.erase(it);
+            m_hitIndex.SetRect(handle, bounds);
         }
         else
         {
-            ++it;
+            m_hitIndex.Remove(handle);
         }
+        ++m_hitTestStats.m_frameBoundsUpdateCount;
+    }
+    m_hitBoundsQueue.clear();
+
+    // 只有真的有範圍改變時格子才會是 dirty
+    if (m_hitIndex.IsDirty())
+    {
+        m_hitIndex.Rebuild();
+    }
+    m_hitTestStats.m_indexedCount = static_cast<uint32_t>(m_hitIndex.GetCount());
+}
+
+void WidgetSubsystem::CleanupGarbageWidgets()
+{
+    // 釋放這一幀之前被標記的 Widget，每個都是 O(1)；Layer 中留下的過期項目由 CompactWidgetLayers 處理
+    for (WidgetHandle const handle : m_pendingDestroyHandles)
+    {
+        if (FindDenseIndex(handle) == INVALID_WIDGET_INDEX) continue;
+
+        DestroyWidget(handle);
+        ++m_poolStats.m_frameSweptCount;
     }
+    m_pendingDestroyHandles.clear();
+    ++m_poolStats.m_sweepCount;
 }
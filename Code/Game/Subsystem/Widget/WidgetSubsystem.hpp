@@ -9,19 +9,124 @@
 #include <unordered_map>
 
 #include "Engine/Core/StringUtils.hpp"
-
-using WidgetPtr = std::shared_ptr<IWidget>;
+#include "Game/Subsystem/Widget/WidgetLayout.hpp"
+#include "Game/Subsystem/Widget/WidgetRenderBatcher.hpp"
+#include "Game/Subsystem/Window/WindowSpatialIndex.hpp"
 
 //----------------------------------------------------------------------------------------------------
 struct sWidgetSubsystemConfig
 {
-    size_t m_initialWidgetCapacity = 64;
-    size_t m_initialOwnerCapacity  = 32;
+    size_t                m_initialWidgetCapacity      = 64;
+    size_t                m_initialOwnerCapacity       = 32;
+    size_t                m_initialBatchVertexCapacity = 4096;
+    IWidgetRenderBackend* m_renderBackend              = nullptr;     // Not owned. nullptr creates and owns a RendererWidgetRenderBackend
+    float                 m_hitTestCellSize            = 256.f;
+    bool                  m_isCursorInputEnabled       = true;        // Update reads the main window cursor and left mouse button
 };
 
 //----------------------------------------------------------------------------------------------------
+// WidgetHandle = (generation << WIDGET_HANDLE_INDEX_BITS) | slot index, the same scheme as WindowID: a
+// stale handle never resolves to whichever widget reuses the slot, and 0 stays the invalid handle.
+static constexpr uint32_t WIDGET_HANDLE_INDEX_BITS      = 20;
+static constexpr uint32_t WIDGET_HANDLE_INDEX_MASK      = (1u << WIDGET_HANDLE_INDEX_BITS) - 1u;
+static constexpr uint32_t WIDGET_HANDLE_GENERATION_MASK = (1u << (32 - WIDGET_HANDLE_INDEX_BITS)) - 1u;
+static constexpr uint32_t INVALID_WIDGET_INDEX          = UINT32_MAX;
+
+struct sWidgetSlot
+{
+    uint32_t m_denseIndex     = INVALID_WIDGET_INDEX;   // Index into m_widgets, or invalid while the slot is free
+    uint32_t m_generation     = 1;
+    void*    m_listOwner      = nullptr;                // Owner whose intrusive list this slot is linked into
+    uint32_t m_prevOwnedSlot  = INVALID_WIDGET_INDEX;
+    uint32_t m_nextOwnedSlot  = INVALID_WIDGET_INDEX;
+    bool     m_isAdded        = false;                  // Added with AddWidget / AddWidgetToEntity
+    bool     m_isLayered      = false;                  // In a layer: added, visible and not garbage
+    int      m_layerZOrder    = 0;
+    uint32_t m_layerSequence  = 0;                      // Bumped on every layer insert, older entries are stale
+    uint32_t m_layoutIndex    = INVALID_WIDGET_INDEX;   // Index into m_layouts when the widget is anchored
+    uint32_t m_layerOrder     = 0;                      // Global insert counter at the last layer insert, later is on top within a z-order
+    bool     m_isHitQueued    = false;                  // Already in m_hitBoundsQueue
+    uint32_t m_tickIndex      = INVALID_WIDGET_INDEX;   // Index into m_tickWidgets while ticking
+    uint32_t m_frameHookIndex = INVALID_WIDGET_INDEX;   // Index into m_frameHookWidgets while it wants BeginFrame / EndFrame
+    bool     m_isListQueued   = false;                  // Already in m_listRefreshQueue
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sWidgetLayout
+{
+    WidgetHandle  m_handle           = 0;
+    sWidgetAnchor m_anchor;
+    WindowID      m_resolvedWindowID = 0;      // Window the bounds were last computed from
+    uint32_t      m_geometryRevision = 0;      // ...and its sWindowGeometry::m_revision at the time
+    bool          m_isDirty          = true;   // Anchor changed since the last pass
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sWidgetLayerEntry
+{
+    WidgetHandle m_handle        = 0;
+    uint32_t     m_layerSequence = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// All visible added widgets with one z-order, in the order they joined. Removing, hiding or re-ordering a
+// widget leaves a stale entry behind instead of shifting the rest; Update compacts a layer once enough have piled up.
+struct sWidgetLayer
+{
+    int                            m_zOrder     = 0;
+    std::vector<sWidgetLayerEntry> m_entries;
+    uint32_t                       m_staleCount = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sWidgetPoolStats
+{
+    size_t   m_liveCount       = 0;
+    uint64_t m_createCount     = 0;
+    uint64_t m_destroyCount    = 0;
+    uint64_t m_sweepCount      = 0;     // Update() calls that had something marked for destroy
+    uint32_t m_frameSweptCount = 0;     // Widgets destroyed by this frame's sweep
+    size_t   m_layerCount      = 0;     // Distinct z-orders in use
+    uint64_t m_compactCount    = 0;     // Layers rebuilt to drop stale entries
+    size_t   m_layeredCount    = 0;     // Widgets Render walks
+    size_t   m_tickCount       = 0;     // Widgets Update walks
+    size_t   m_frameHookCount  = 0;     // Widgets BeginFrame / EndFrame walk
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sWidgetHitTestStats
+{
+    uint32_t m_indexedCount           = 0;     // Visible widgets with hit bounds
+    uint32_t m_frameBoundsUpdateCount = 0;     // Widgets re-indexed this frame because bounds or visibility changed
+    uint64_t m_queryCount             = 0;
+    uint64_t m_candidateCount         = 0;     // Hits returned by the grid before picking the topmost
+    uint64_t m_enterCount             = 0;
+    uint64_t m_leaveCount             = 0;
+    uint64_t m_clickCount             = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Widgets live in a dense pool addressed by WidgetHandle. Adding and destroying are O(1) (swap-remove),
+// each owner's widgets are an intrusive list threaded through the slots, and garbage is swept from a
+// queue filled by MarkForDestroy, so frames where nothing died do no cleanup work.
+//
+// Draw order comes from m_layers, kept sorted by z-order: adding a widget is a binary search for its
+// layer plus an append, so order inside a layer is insertion order and nothing is ever globally sorted.
+//
+// Each frame phase only walks the widgets that need it. The layers hold visible widgets only (showing a
+// hidden widget appends it to its layer again), Update walks m_tickWidgets and BeginFrame / EndFrame walk
+// m_frameHookWidgets. Widgets join and leave through RefreshWidgetLists when SetVisible, SetTick,
+// SetWantsFrameHooks or MarkForDestroy change something; changes made while a phase is walking a list are
+// queued and applied once that walk ends.
+//
+// Cursor input goes through a WindowSpatialIndex over the hit bounds of visible widgets (its keys are plain
+// uint32, so widget handles index the same way window IDs do). Only widgets whose bounds or visibility
+// changed are re-indexed, and only the topmost widget under the cursor receives hover, enter, leave and click.
+//
 class WidgetSubsystem
 {
+    friend class IWidget;
+
 public:
     explicit WidgetSubsystem(sWidgetSubsystemConfig const& config);
     ~WidgetSubsystem();
@@ -34,41 +139,100 @@ public:
     void ShutDown();
 
     /// Widget Management
-    void AddWidget(WidgetPtr const& widget, int zOrder = 0);
-    void AddWidgetToEntity(WidgetPtr const& widget, void* entity, int zOrder = 0);
-    void RemoveWidget(WidgetPtr const& widget);
+    void AddWidget(IWidget* widget, int zOrder = 0);
+    void AddWidgetToEntity(IWidget* widget, void* entity, int zOrder = 0);
+    void RemoveWidget(IWidget* widget);
     void RemoveAllWidgetsFromEntity(void* entity);
     void RemoveAllWidgets();
 
     /// Widget Queries
-    WidgetPtr              FindWidgetByName(String const& name) const;
-    std::vector<WidgetPtr> GetWidgetsByOwner(void* owner) const;
-    std::vector<WidgetPtr> GetAllWidgets() const;
+    IWidget*              GetWidget(WidgetHandle handle) const;
+    IWidget*              FindWidgetByName(String const& name) const;
+    std::vector<IWidget*> GetWidgetsByOwner(void* owner) const;
+    std::vector<IWidget*> GetAllWidgets() const;
+    sWidgetPoolStats      GetPoolStats() const;
 
     /// Viewport Management
-    void      SetViewportWidget(WidgetPtr const& widget);
-    WidgetPtr GetViewportWidget() const;
+    void     SetViewportWidget(IWidget* widget);
+    IWidget* GetViewportWidget() const;
 
-    /// Template function for creating widgets
-    template <typename T, typename... Args>
-    std::shared_ptr<T> CreateWidget(Args&&... args);
+    /// Layout: anchored widgets follow their window's client rect, resolved once per Update
+    void                      SetWidgetAnchor(IWidget* widget, sWidgetAnchor const& anchor);
+    void                      ClearWidgetAnchor(IWidget* widget);
+    sWidgetLayoutStats const& GetLayoutStats() const;
+
+    /// Cursor input
+    IWidget*                   PickWidgetAt(Vec2 const& point) const;
+    void                       ProcessCursor(Vec2 const& cursorPosition, bool isClicked);
+    IWidget*                   GetHoveredWidget() const;
+    sWidgetHitTestStats const& GetHitTestStats() const;
 
-    bool m_bNeedsSorting = false;
+    /// Rendering
+    sWidgetRenderStats const& GetRenderStats() const;
+    IWidgetRenderBackend*     GetRenderBackend() const;
+
+    /// Constructs the widget inside the pool. It is owned by the subsystem and is not updated or drawn
+    /// until AddWidget; release it with MarkForDestroy (or RemoveWidget), never delete it.
+    template <typename T, typename... Args>
+    T* CreateWidget(Args&&... args);
 
 private:
-    void                                              SortWidgetsByZOrder();
-    void                                              CleanupGarbageWidgets();
-    sWidgetSubsystemConfig                            m_config;
-    std::vector<WidgetPtr>                            m_widgets;
-    std::unordered_map<void*, std::vector<WidgetPtr>> m_ownerWidgetsMapping;
-    WidgetPtr                                         m_viewportWidget = nullptr;
+    WidgetHandle AdoptWidget(std::unique_ptr<IWidget> widget);
+    void         QueueWidgetDestroy(WidgetHandle handle);
+    void         DestroyWidget(WidgetHandle handle);
+    uint32_t     FindDenseIndex(WidgetHandle handle) const;
+    void         LinkOwnedWidget(uint32_t slotIndex, void* owner);
+    void         UnlinkOwnedWidget(uint32_t slotIndex);
+    void         InsertWidgetIntoLayer(uint32_t slotIndex, int zOrder);
+    void         RemoveWidgetFromLayer(uint32_t slotIndex);
+    void         MoveWidgetToLayer(WidgetHandle handle, int zOrder);
+    void         RefreshWidgetLists(WidgetHandle handle);
+    void         ApplyQueuedListRefreshes();
+    void         SetWidgetListMembership(std::vector<WidgetHandle>& list, uint32_t sWidgetSlot::* listIndex, uint32_t slotIndex, bool isMember);
+    IWidget*     ResolveLayerEntry(sWidgetLayerEntry const& entry) const;
+    void         CompactWidgetLayers();
+    void         RemoveWidgetLayout(uint32_t slotIndex);
+    void         ResolveWidgetLayouts();
+    void         QueueWidgetHitBoundsUpdate(WidgetHandle handle);
+    void         UpdateWidgetHitIndex();
+    void         CleanupGarbageWidgets();
+
+    sWidgetSubsystemConfig                   m_config;
+    std::vector<std::unique_ptr<IWidget>>    m_widgets;                // Dense pool, swap-removed
+    std::vector<WidgetHandle>                m_denseWidgetHandles;     // 與 m_widgets 平行：m_widgets[i] 的 handle
+    std::vector<sWidgetSlot>                 m_widgetSlots;            // Handle 的 slot index -> m_widgets 索引、世代與 owner 串列
+    std::vector<uint32_t>                    m_freeWidgetSlots;
+    std::unordered_map<void*, uint32_t>      m_ownerFirstSlot;         // Owner -> head of its intrusive list
+    std::vector<sWidgetLayer>                m_layers;                 // Sorted by m_zOrder, back to front
+    bool                                     m_hasStaleLayerEntries = false;
+    std::vector<WidgetHandle>                m_tickWidgets;            // Unordered, swap-removed
+    std::vector<WidgetHandle>                m_frameHookWidgets;       // Unordered, swap-removed
+    std::vector<WidgetHandle>                m_listRefreshQueue;       // Changes made during a walk
+    bool                                     m_isWalkingWidgets = false;
+    std::vector<sWidgetLayout>               m_layouts;                // Dense, swap-removed
+    sWidgetLayoutStats                       m_layoutStats;
+    uint32_t                                 m_nextLayerOrder = 0;
+    WindowSpatialIndex                       m_hitIndex;
+    std::vector<WidgetHandle>                m_hitBoundsQueue;         // Widgets to re-index, filled by NotifyBoundsChanged
+    mutable std::vector<WindowID>            m_hitScratch;
+    WidgetHandle                             m_hoveredWidget = 0;
+    mutable sWidgetHitTestStats              m_hitTestStats;
+    std::vector<WidgetHandle>                m_pendingDestroyHandles;  // Filled by MarkForDestroy, drained by Update
+    WidgetHandle                             m_viewportWidget = 0;
+    sWidgetPoolStats                         m_poolStats;
+    IWidgetRenderBackend*                    m_renderBackend  = nullptr;
+    std::unique_ptr<IWidgetRenderBackend>    m_ownedRenderBackend;
+    mutable WidgetRenderBatcher              m_renderBatcher;
 };
 
 //----------------------------------------------------------------------------------------------------
 template <typename T, typename... Args>
-std::shared_ptr<T> WidgetSubsystem::CreateWidget(Args&&... args)
+T* WidgetSubsystem::CreateWidget(Args&&... args)
 {
     static_assert(std::is_base_of_v<IWidget, T>, "T must derive from Widget");
 
-    return std::make_shared<T>(std::forward<Args>(args)...);
+    std::unique_ptr<T> widget    = std::make_unique<T>(std::forward<Args>(args)...);
+    T*                 rawWidget = widget.get();
+
+    return AdoptWidget(std::move(widget)) != 0 ? rawWidget : nullptr;
 }
@@ -0,0 +1,67 @@
+//----------------------------------------------------------------------------------------------------
+// IWindowBackend.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Window/IWindowBackend.hpp"
+
+//----------------------------------------------------------------------------------------------------
+uint64_t sWindowBackendStats::GetTotalCallCount() const
+{
+    uint64_t total = 0;
+    for (int opIndex = 0; opIndex < OP_COUNT; ++opIndex)
+    {
+        total += m_callCount[opIndex];
+    }
+    return total;
+}
+
+//----------------------------------------------------------------------------------------------------
+double sWindowBackendStats::GetTotalSeconds() const
+{
+    double total = 0.0;
+    for (int opIndex = 0; opIndex < OP_COUNT; ++opIndex)
+    {
+        total += m_totalSeconds[opIndex];
+    }
+    return total;
+}
+
+//----------------------------------------------------------------------------------------------------
+sWindowBackendStats const& IWindowBackend::GetStats() const
+{
+    return m_stats;
+}
+
+//----------------------------------------------------------------------------------------------------
+void IWindowBackend::ResetStats()
+{
+    m_stats = sWindowBackendStats{};
+}
+
+//----------------------------------------------------------------------------------------------------
+void IWindowBackend::RecordOperation(eWindowBackendOp const op, double const seconds)
+{
+    int const opIndex = static_cast<int>(op);
+    ++m_stats.m_callCount[opIndex];
+    m_stats.m_totalSeconds[opIndex] += seconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+char const* GetWindowBackendOpName(eWindowBackendOp const op)
+{
+    switch (op)
+    {
+    case eWindowBackendOp::CREATE_WINDOW: return "CreateWindow";
+    case eWindowBackendOp::DESTROY_WINDOW: return "DestroyWindow";
+    case eWindowBackendOp::ACQUIRE_DISPLAY_CONTEXT: return "AcquireDisplayContext";
+    case eWindowBackendOp::SET_VISIBLE: return "SetVisible";
+    case eWindowBackendOp::SET_TITLE: return "SetTitle";
+    case eWindowBackendOp::SET_CLIENT_POSITION: return "SetClientPosition";
+    case eWindowBackendOp::SET_CLIENT_DIMENSIONS: return "SetClientDimensions";
+    case eWindowBackendOp::QUERY_CLIENT_RECT: return "QueryClientRect";
+    case eWindowBackendOp::QUERY_Z_ORDER: return "QueryZOrder";
+    case eWindowBackendOp::COUNT: break;
+    }
+    return "Unknown";
+}
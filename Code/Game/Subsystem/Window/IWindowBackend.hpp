@@ -0,0 +1,91 @@
+//----------------------------------------------------------------------------------------------------
+// IWindowBackend.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "Engine/Core/StringUtils.hpp"
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/Vec2.hpp"
+
+//-Forward-Declaration--------------------------------------------------------------------------------
+class Window;
+
+//----------------------------------------------------------------------------------------------------
+using NativeWindowHandle = void*;
+
+//----------------------------------------------------------------------------------------------------
+enum class eWindowBackendOp : uint8_t
+{
+    CREATE_WINDOW,
+    DESTROY_WINDOW,
+    ACQUIRE_DISPLAY_CONTEXT,
+    SET_VISIBLE,
+    SET_TITLE,
+    SET_CLIENT_POSITION,
+    SET_CLIENT_DIMENSIONS,
+    QUERY_CLIENT_RECT,
+    QUERY_Z_ORDER,
+    COUNT
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sWindowBackendStats
+{
+    static constexpr int OP_COUNT = static_cast<int>(eWindowBackendOp::COUNT);
+
+    uint64_t m_callCount[OP_COUNT]    = {};
+    double   m_totalSeconds[OP_COUNT] = {};     // Measured on native backends, simulated on the mock
+
+    uint64_t GetTotalCallCount() const;
+    double   GetTotalSeconds() const;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Every OS window operation WindowSubsystem performs goes through this interface, so window-heavy
+// scenarios can run against MockWindowBackend without a desktop.
+//
+// Geometry calls take both the native handle and the engine Window. Native backends drive the
+// Window (which owns the client/screen coordinate conversion) and fall back to the OS by handle when
+// it is nullptr, which is how a window thread moves windows; the mock keys its rects by handle and
+// never touches the Window, which is nullptr for windows it created.
+//
+class IWindowBackend
+{
+public:
+    virtual ~IWindowBackend() = default;
+
+    /// Native backends hand out real handles that need a DC, an engine Window and a swap chain.
+    virtual bool IsNative() const = 0;
+
+    virtual NativeWindowHandle CreateNativeWindow(String const& title, int x, int y, int width, int height) = 0;
+    virtual void               DestroyNativeWindow(NativeWindowHandle handle, Window* window) = 0;
+    virtual void*              AcquireDisplayContext(NativeWindowHandle handle) = 0;
+    virtual void               SetVisible(NativeWindowHandle handle, bool isVisible) = 0;
+    virtual void               SetTitle(NativeWindowHandle handle, String const& title) = 0;
+    virtual void               SetClientPosition(NativeWindowHandle handle, Window* window, Vec2 const& clientPosition) = 0;
+    virtual void               SetClientDimensions(NativeWindowHandle handle, Window* window, Vec2 const& clientDimensions) = 0;
+    virtual AABB2              GetClientRect(NativeWindowHandle handle, Window* window) = 0;
+
+    /// Writes one rank per handle into out_zOrders, 0 is topmost. Handles the backend does not know rank last.
+    virtual void QueryZOrder(std::vector<NativeWindowHandle> const& handles, std::vector<uint32_t>& out_zOrders) = 0;
+
+    /// Dispatches pending OS messages for windows created on the calling thread. The main loop already
+    /// does this for the game thread, only a dedicated window thread needs to call it.
+    virtual void PumpMessages() {}
+
+    sWindowBackendStats const& GetStats() const;
+    void                       ResetStats();
+
+protected:
+    void RecordOperation(eWindowBackendOp op, double seconds);
+
+private:
+    sWindowBackendStats m_stats;
+};
+
+//----------------------------------------------------------------------------------------------------
+char const* GetWindowBackendOpName(eWindowBackendOp op);
@@ -0,0 +1,267 @@
+//----------------------------------------------------------------------------------------------------
+// MockWindowBackend.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Window/MockWindowBackend.hpp"
+
+#include <algorithm>
+
+#include "Engine/Core/EngineCommon.hpp"
+
+//----------------------------------------------------------------------------------------------------
+MockWindowBackend::MockWindowBackend()
+{
+    // Rough desktop figures for each Win32 call, benchmarks can override them with SetSimulatedCost.
+    SetSimulatedCost(eWindowBackendOp::CREATE_WINDOW, 2.0e-3);
+    SetSimulatedCost(eWindowBackendOp::DESTROY_WINDOW, 1.0e-3);
+    SetSimulatedCost(eWindowBackendOp::ACQUIRE_DISPLAY_CONTEXT, 2.0e-5);
+    SetSimulatedCost(eWindowBackendOp::SET_VISIBLE, 1.0e-4);
+    SetSimulatedCost(eWindowBackendOp::SET_TITLE, 5.0e-5);
+    SetSimulatedCost(eWindowBackendOp::SET_CLIENT_POSITION, 1.5e-4);
+    SetSimulatedCost(eWindowBackendOp::SET_CLIENT_DIMENSIONS, 3.0e-4);
+    SetSimulatedCost(eWindowBackendOp::QUERY_CLIENT_RECT, 5.0e-6);
+    SetSimulatedCost(eWindowBackendOp::QUERY_Z_ORDER, 2.0e-5);
+}
+
+//----------------------------------------------------------------------------------------------------
+bool MockWindowBackend::IsNative() const
+{
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+NativeWindowHandle MockWindowBackend::CreateNativeWindow(String const& title,
+                                                         int const     x,
+                                                         int const     y,
+                                                         int const     width,
+                                                         int const     height)
+{
+    uintptr_t const handleValue = m_nextHandle++;
+    Charge(eWindowBackendOp::CREATE_WINDOW, reinterpret_cast<NativeWindowHandle>(handleValue), Vec2(x, y));
+
+    sMockWindow& mockWindow = m_windows[handleValue];
+    mockWindow.m_title      = title;
+    mockWindow.m_clientRect = AABB2(Vec2(x, y), Vec2(x + width, y + height));
+    mockWindow.m_isVisible  = false;
+    mockWindow.m_raiseOrder = m_nextRaiseOrder++;
+
+    return reinterpret_cast<NativeWindowHandle>(handleValue);
+}
+
+//----------------------------------------------------------------------------------------------------
+void MockWindowBackend::DestroyNativeWindow(NativeWindowHandle const handle, Window* window)
+{
+    UNUSED(window)
+    Charge(eWindowBackendOp::DESTROY_WINDOW, handle);
+
+    m_windows.erase(reinterpret_cast<uintptr_t>(handle));
+}
+
+//----------------------------------------------------------------------------------------------------
+void* MockWindowBackend::AcquireDisplayContext(NativeWindowHandle const handle)
+{
+    Charge(eWindowBackendOp::ACQUIRE_DISPLAY_CONTEXT, handle);
+
+    return nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+void MockWindowBackend::SetVisible(NativeWindowHandle const handle, bool const isVisible)
+{
+    Charge(eWindowBackendOp::SET_VISIBLE, handle, Vec2(isVisible ? 1.f : 0.f, 0.f));
+
+    sMockWindow* mockWindow = FindMockWindow(handle);
+    if (mockWindow == nullptr) return;
+
+    // Showing a window brings it to the top, like SW_SHOW on a newly activated window
+    if (isVisible && !mockWindow->m_isVisible) mockWindow->m_raiseOrder = m_nextRaiseOrder++;
+    mockWindow->m_isVisible = isVisible;
+}
+
+//----------------------------------------------------------------------------------------------------
+void MockWindowBackend::SetTitle(NativeWindowHandle const handle, String const& title)
+{
+    Charge(eWindowBackendOp::SET_TITLE, handle);
+
+    sMockWindow* mockWindow = FindMockWindow(handle);
+    if (mockWindow != nullptr) mockWindow->m_title = title;
+}
+
+//----------------------------------------------------------------------------------------------------
+void MockWindowBackend::SetClientPosition(NativeWindowHandle const handle, Window* window, Vec2 const& clientPosition)
+{
+    UNUSED(window)
+    Charge(eWindowBackendOp::SET_CLIENT_POSITION, handle, clientPosition);
+
+    sMockWindow* mockWindow = FindMockWindow(handle);
+    if (mockWindow == nullptr) return;
+
+    if (m_simulatedMoveLatency > 0)
+    {
+        sPendingMockMove pendingMove;
+        pendingMove.m_handleValue    = reinterpret_cast<uintptr_t>(handle);
+        pendingMove.m_clientPosition = clientPosition;
+        pendingMove.m_applyFrame     = m_simulatedFrame + m_simulatedMoveLatency;
+        m_pendingMoves.push_back(pendingMove);
+        return;
+    }
+
+    Vec2 const dimensions           = mockWindow->m_clientRect.m_maxs - mockWindow->m_clientRect.m_mins;
+    mockWindow->m_clientRect.m_mins = clientPosition;
+    mockWindow->m_clientRect.m_maxs = clientPosition + dimensions;
+}
+
+//----------------------------------------------------------------------------------------------------
+void MockWindowBackend::SetClientDimensions(NativeWindowHandle const handle, Window* window, Vec2 const& clientDimensions)
+{
+    UNUSED(window)
+    Charge(eWindowBackendOp::SET_CLIENT_DIMENSIONS, handle, clientDimensions);
+
+    sMockWindow* mockWindow = FindMockWindow(handle);
+    if (mockWindow == nullptr) return;
+
+    mockWindow->m_clientRect.m_maxs = mockWindow->m_clientRect.m_mins + clientDimensions;
+}
+
+//----------------------------------------------------------------------------------------------------
+AABB2 MockWindowBackend::GetClientRect(NativeWindowHandle const handle, Window* window)
+{
+    UNUSED(window)
+    Charge(eWindowBackendOp::QUERY_CLIENT_RECT, handle);
+
+    sMockWindow const* mockWindow = FindMockWindow(handle);
+    return mockWindow != nullptr ? mockWindow->m_clientRect : AABB2();
+}
+
+//----------------------------------------------------------------------------------------------------
+void MockWindowBackend::QueryZOrder(std::vector<NativeWindowHandle> const& handles, std::vector<uint32_t>& out_zOrders)
+{
+    Charge(eWindowBackendOp::QUERY_Z_ORDER);
+
+    // Rank = number of known windows raised after this one
+    std::vector<uint64_t> raiseOrders;
+    raiseOrders.reserve(m_windows.size());
+    for (auto const& [handleValue, mockWindow] : m_windows)
+    {
+        raiseOrders.push_back(mockWindow.m_raiseOrder);
+    }
+    std::sort(raiseOrders.begin(), raiseOrders.end());
+
+    out_zOrders.resize(handles.size());
+    for (size_t handleIndex = 0; handleIndex < handles.size(); ++handleIndex)
+    {
+        sMockWindow const* mockWindow = FindMockWindow(handles[handleIndex]);
+        if (mockWindow == nullptr)
+        {
+            out_zOrders[handleIndex] = UINT32_MAX;
+            continue;
+        }
+
+        auto const raisedAfter   = raiseOrders.end() - std::upper_bound(raiseOrders.begin(), raiseOrders.end(), mockWindow->m_raiseOrder);
+        out_zOrders[handleIndex] = static_cast<uint32_t>(raisedAfter);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void MockWindowBackend::SetSimulatedCost(eWindowBackendOp const op, double const seconds)
+{
+    m_simulatedCostSeconds[static_cast<int>(op)] = seconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+double MockWindowBackend::GetSimulatedCost(eWindowBackendOp const op) const
+{
+    return m_simulatedCostSeconds[static_cast<int>(op)];
+}
+
+//----------------------------------------------------------------------------------------------------
+sMockWindow const* MockWindowBackend::FindMockWindow(NativeWindowHandle const handle) const
+{
+    auto const it = m_windows.find(reinterpret_cast<uintptr_t>(handle));
+    return it != m_windows.end() ? &it->second : nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t MockWindowBackend::GetLiveWindowCount() const
+{
+    return m_windows.size();
+}
+
+//----------------------------------------------------------------------------------------------------
+std::vector<sMockWindowCall> const& MockWindowBackend::GetCallLog() const
+{
+    return m_callLog;
+}
+
+//----------------------------------------------------------------------------------------------------
+void MockWindowBackend::ClearCallLog()
+{
+    m_callLog.clear();
+}
+
+//----------------------------------------------------------------------------------------------------
+void MockWindowBackend::SetCallLogEnabled(bool const isEnabled)
+{
+    // Long benchmarks can turn the log off so it does not grow without bound
+    m_isCallLogEnabled = isEnabled;
+}
+
+//----------------------------------------------------------------------------------------------------
+void MockWindowBackend::SetSimulatedMoveLatency(uint32_t const frames)
+{
+    m_simulatedMoveLatency = frames;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t MockWindowBackend::GetSimulatedMoveLatency() const
+{
+    return m_simulatedMoveLatency;
+}
+
+//----------------------------------------------------------------------------------------------------
+void MockWindowBackend::AdvanceSimulatedFrame()
+{
+    ++m_simulatedFrame;
+
+    // Requests land in the order they were made, a later move of the same window wins
+    size_t keptCount = 0;
+    for (sPendingMockMove const& pendingMove : m_pendingMoves)
+    {
+        if (pendingMove.m_applyFrame > m_simulatedFrame)
+        {
+            m_pendingMoves[keptCount++] = pendingMove;
+            continue;
+        }
+
+        auto const it = m_windows.find(pendingMove.m_handleValue);
+        if (it == m_windows.end()) continue;
+
+        AABB2&     clientRect = it->second.m_clientRect;
+        Vec2 const dimensions = clientRect.m_maxs - clientRect.m_mins;
+        clientRect.m_mins     = pendingMove.m_clientPosition;
+        clientRect.m_maxs     = pendingMove.m_clientPosition + dimensions;
+    }
+    m_pendingMoves.resize(keptCount);
+}
+
+//----------------------------------------------------------------------------------------------------
+sMockWindow* MockWindowBackend::FindMockWindow(NativeWindowHandle const handle)
+{
+    auto const it = m_windows.find(reinterpret_cast<uintptr_t>(handle));
+    return it != m_windows.end() ? &it->second : nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+void MockWindowBackend::Charge(eWindowBackendOp const op, NativeWindowHandle const handle, Vec2 const& value)
+{
+    RecordOperation(op, m_simulatedCostSeconds[static_cast<int>(op)]);
+
+    if (!m_isCallLogEnabled) return;
+
+    sMockWindowCall call;
+    call.m_op          = op;
+    call.m_handleValue = reinterpret_cast<uintptr_t>(handle);
+    call.m_value       = value;
+    m_callLog.push_back(call);
+}
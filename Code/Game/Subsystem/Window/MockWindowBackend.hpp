@@ -0,0 +1,92 @@
+//----------------------------------------------------------------------------------------------------
+// MockWindowBackend.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <unordered_map>
+#include <vector>
+
+#include "Game/Subsystem/Window/IWindowBackend.hpp"
+
+//----------------------------------------------------------------------------------------------------
+struct sMockWindow
+{
+    String   m_title;
+    AABB2    m_clientRect;
+    bool     m_isVisible  = false;
+    uint64_t m_raiseOrder = 0;     // Larger is higher in the z-order, bumped on create and show
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sPendingMockMove
+{
+    uintptr_t m_handleValue    = 0;
+    Vec2      m_clientPosition = Vec2::ZERO;
+    uint64_t  m_applyFrame     = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// One entry of MockWindowBackend's call log. m_value is the call's argument where it has one: the requested
+// client position for CREATE_WINDOW and SET_CLIENT_POSITION, the dimensions for SET_CLIENT_DIMENSIONS and
+// (1, 0) / (0, 0) for SET_VISIBLE. QUERY_Z_ORDER has no handle.
+struct sMockWindowCall
+{
+    eWindowBackendOp m_op          = eWindowBackendOp::COUNT;
+    uintptr_t        m_handleValue = 0;
+    Vec2             m_value       = Vec2::ZERO;
+};
+
+//----------------------------------------------------------------------------------------------------
+// In-memory backend: no HWNDs, no DCs, no swap chains. Keeps every window's rect, visibility and
+// title, counts each call and charges it a simulated cost so window-heavy scenarios can be
+// benchmarked off Windows, and logs every call in order so regression tests can assert on the exact
+// sequence WindowSubsystem issued.
+//
+// SetSimulatedMoveLatency delays client position changes by a number of AdvanceSimulatedFrame calls, the
+// way the OS applies moves a frame or more after they are requested. GetClientRect reports the old rect
+// until then.
+//
+class MockWindowBackend : public IWindowBackend
+{
+public:
+    MockWindowBackend();
+
+    bool               IsNative() const override;
+    NativeWindowHandle CreateNativeWindow(String const& title, int x, int y, int width, int height) override;
+    void               DestroyNativeWindow(NativeWindowHandle handle, Window* window) override;
+    void*              AcquireDisplayContext(NativeWindowHandle handle) override;
+    void               SetVisible(NativeWindowHandle handle, bool isVisible) override;
+    void               SetTitle(NativeWindowHandle handle, String const& title) override;
+    void               SetClientPosition(NativeWindowHandle handle, Window* window, Vec2 const& clientPosition) override;
+    void               SetClientDimensions(NativeWindowHandle handle, Window* window, Vec2 const& clientDimensions) override;
+    AABB2              GetClientRect(NativeWindowHandle handle, Window* window) override;
+    void               QueryZOrder(std::vector<NativeWindowHandle> const& handles, std::vector<uint32_t>& out_zOrders) override;
+
+    void               SetSimulatedCost(eWindowBackendOp op, double seconds);
+    double             GetSimulatedCost(eWindowBackendOp op) const;
+    sMockWindow const* FindMockWindow(NativeWindowHandle handle) const;
+    size_t             GetLiveWindowCount() const;
+
+    std::vector<sMockWindowCall> const& GetCallLog() const;
+    void                                ClearCallLog();
+    void                                SetCallLogEnabled(bool isEnabled);
+
+    void     SetSimulatedMoveLatency(uint32_t frames);
+    uint32_t GetSimulatedMoveLatency() const;
+    void     AdvanceSimulatedFrame();
+
+private:
+    sMockWindow* FindMockWindow(NativeWindowHandle handle);
+    void         Charge(eWindowBackendOp op, NativeWindowHandle handle = nullptr, Vec2 const& value = Vec2::ZERO);
+
+    std::unordered_map<uintptr_t, sMockWindow> m_windows;
+    uintptr_t                                  m_nextHandle     = 1;     // 0 stays the invalid handle
+    uint64_t                                   m_nextRaiseOrder = 1;
+    double                                     m_simulatedCostSeconds[sWindowBackendStats::OP_COUNT] = {};
+    uint32_t                                   m_simulatedMoveLatency = 0;
+    uint64_t                                   m_simulatedFrame       = 0;
+    std::vector<sPendingMockMove>              m_pendingMoves;      // In request order
+    std::vector<sMockWindowCall>               m_callLog;           // Every call in order, until ClearCallLog
+    bool                                       m_isCallLogEnabled = true;
+};
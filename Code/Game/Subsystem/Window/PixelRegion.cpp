@@ -0,0 +1,106 @@
+//----------------------------------------------------------------------------------------------------
+// PixelRegion.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Window/PixelRegion.hpp"
+
+#include <algorithm>
+
+#include "Engine/Core/EngineCommon.hpp"
+
+//----------------------------------------------------------------------------------------------------
+STATIC void PixelRegion::ComputeUnion(std::vector<sPixelRect> const& rects,
+                                      sPixelRect const&              bounds,
+                                      std::vector<sPixelRect>&       out_region)
+{
+    out_region.clear();
+
+    std::vector<sPixelRect> clippedRects;
+    std::vector<int>        bandEdges;
+    clippedRects.reserve(rects.size());
+    bandEdges.reserve(rects.size() * 2);
+
+    for (sPixelRect const& rect : rects)
+    {
+        sPixelRect const clipped = rect.GetIntersection(bounds);
+        if (clipped.IsEmpty()) continue;
+
+        clippedRects.push_back(clipped);
+        bandEdges.push_back(clipped.m_minY);
+        bandEdges.push_back(clipped.m_maxY);
+    }
+
+    std::sort(bandEdges.begin(), bandEdges.end());
+    bandEdges.erase(std::unique(bandEdges.begin(), bandEdges.end()), bandEdges.end());
+
+    // Sweep horizontal bands between consecutive edges, merge the x spans covering each band, and grow
+    // the rects of the previous band downward when its spans are identical.
+    std::vector<std::pair<int, int>> spans;
+    size_t                           previousBandBegin = 0;
+    size_t                           previousBandEnd   = 0;
+
+    for (size_t edgeIndex = 0; edgeIndex + 1 < bandEdges.size(); ++edgeIndex)
+    {
+        int const bandMinY = bandEdges[edgeIndex];
+        int const bandMaxY = bandEdges[edgeIndex + 1];
+
+        spans.clear();
+        for (sPixelRect const& rect : clippedRects)
+        {
+            if (rect.m_minY <= bandMinY && rect.m_maxY >= bandMaxY) spans.emplace_back(rect.m_minX, rect.m_maxX);
+        }
+
+        std::sort(spans.begin(), spans.end());
+
+        size_t mergedCount = 0;
+        for (std::pair<int, int> const& span : spans)
+        {
+            if (mergedCount > 0 && span.first <= spans[mergedCount - 1].second)
+            {
+                spans[mergedCount - 1].second = std::max(spans[mergedCount - 1].second, span.second);
+            }
+            else
+            {
+                spans[mergedCount++] = span;
+            }
+        }
+        spans.resize(mergedCount);
+
+        bool canExtendPreviousBand = previousBandEnd - previousBandBegin == spans.size() && !spans.empty();
+        for (size_t spanIndex = 0; canExtendPreviousBand && spanIndex < spans.size(); ++spanIndex)
+        {
+            sPixelRect const& previous = out_region[previousBandBegin + spanIndex];
+            canExtendPreviousBand      = previous.m_maxY == bandMinY && previous.m_minX == spans[spanIndex].first && previous.m_maxX == spans[spanIndex].second;
+        }
+
+        if (canExtendPreviousBand)
+        {
+            for (size_t regionIndex = previousBandBegin; regionIndex < previousBandEnd; ++regionIndex)
+            {
+                out_region[regionIndex].m_maxY = bandMaxY;
+            }
+            continue;
+        }
+
+        previousBandBegin = out_region.size();
+        for (std::pair<int, int> const& span : spans)
+        {
+            out_region.push_back({span.first, bandMinY, span.second, bandMaxY});
+        }
+        previousBandEnd = out_region.size();
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+STATIC int64_t PixelRegion::GetArea(std::vector<sPixelRect> const& region)
+{
+    int64_t area = 0;
+
+    for (sPixelRect const& rect : region)
+    {
+        area += rect.GetArea();
+    }
+
+    return area;
+}
@@ -0,0 +1,39 @@
+//----------------------------------------------------------------------------------------------------
+// PixelRegion.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+//----------------------------------------------------------------------------------------------------
+// Half-open pixel rectangle [min, max) in screen pixels, origin at the top-left.
+struct sPixelRect
+{
+    int m_minX = 0;
+    int m_minY = 0;
+    int m_maxX = 0;
+    int m_maxY = 0;
+
+    int     GetWidth() const { return m_maxX - m_minX; }
+    int     GetHeight() const { return m_maxY - m_minY; }
+    bool    IsEmpty() const { return m_maxX <= m_minX || m_maxY <= m_minY; }
+    int64_t GetArea() const { return IsEmpty() ? 0 : static_cast<int64_t>(GetWidth()) * GetHeight(); }
+    bool    Overlaps(sPixelRect const& other) const { return !GetIntersection(other).IsEmpty(); }
+
+    sPixelRect GetIntersection(sPixelRect const& other) const
+    {
+        return {std::max(m_minX, other.m_minX), std::max(m_minY, other.m_minY), std::min(m_maxX, other.m_maxX), std::min(m_maxY, other.m_maxY)};
+    }
+};
+
+//----------------------------------------------------------------------------------------------------
+class PixelRegion
+{
+public:
+    /// Clips every rect to bounds and writes their union as non-overlapping rects, so each pixel is counted once.
+    static void    ComputeUnion(std::vector<sPixelRect> const& rects, sPixelRect const& bounds, std::vector<sPixelRect>& out_region);
+    static int64_t GetArea(std::vector<sPixelRect> const& region);
+};
@@ -0,0 +1,374 @@
+//----------------------------------------------------------------------------------------------------
+// ThreadedWindowBackend.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Window/ThreadedWindowBackend.hpp"
+
+#include <algorithm>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Platform/Window.hpp"
+
+//----------------------------------------------------------------------------------------------------
+using CommandClock = sWindowCommand::CommandClock;
+
+static constexpr double GEOMETRY_REFRESH_SECONDS = 1.0 / 60.0;     // Re-read every rect and the z-order at least this often
+
+static double GetSecondsSince(CommandClock::time_point const start)
+{
+    std::chrono::duration<double> const elapsed = CommandClock::now() - start;
+    return elapsed.count();
+}
+
+//----------------------------------------------------------------------------------------------------
+ThreadedWindowBackend::ThreadedWindowBackend(IWindowBackend& innerBackend, uint32_t const queueCapacity)
+    : m_innerBackend(innerBackend),
+      m_queue(queueCapacity),
+      m_publishedSnapshot(std::make_shared<sWindowGeometrySnapshot>())
+{
+    m_windowThread = std::thread(&ThreadedWindowBackend::RunWindowThread, this);
+}
+
+//----------------------------------------------------------------------------------------------------
+ThreadedWindowBackend::~ThreadedWindowBackend()
+{
+    // 視窗執行緒會先把佇列中剩下的命令做完再結束
+    m_isRunning.store(false, std::memory_order_release);
+    m_wakeCondition.notify_one();
+
+    if (m_windowThread.joinable()) m_windowThread.join();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool ThreadedWindowBackend::IsNative() const
+{
+    return m_innerBackend.IsNative();
+}
+
+//----------------------------------------------------------------------------------------------------
+NativeWindowHandle ThreadedWindowBackend::CreateNativeWindow(String const& title,
+                                                             int const     x,
+                                                             int const     y,
+                                                             int const     width,
+                                                             int const     height)
+{
+    sWindowCommand command;
+    command.m_op           = eWindowBackendOp::CREATE_WINDOW;
+    command.m_title        = title;
+    command.m_createX      = x;
+    command.m_createY      = y;
+    command.m_createWidth  = width;
+    command.m_createHeight = height;
+
+    sWindowCommandReply reply;
+    PostAndWait(command, reply);
+    return reply.m_handle;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ThreadedWindowBackend::DestroyNativeWindow(NativeWindowHandle const handle, Window* window)
+{
+    // 呼叫端在這之後就會刪除 Window，所以必須等視窗執行緒真的關閉它
+    sWindowCommand command;
+    command.m_op     = eWindowBackendOp::DESTROY_WINDOW;
+    command.m_handle = handle;
+    command.m_window = window;
+
+    sWindowCommandReply reply;
+    PostAndWait(command, reply);
+}
+
+//----------------------------------------------------------------------------------------------------
+void* ThreadedWindowBackend::AcquireDisplayContext(NativeWindowHandle const handle)
+{
+    sWindowCommand command;
+    command.m_op     = eWindowBackendOp::ACQUIRE_DISPLAY_CONTEXT;
+    command.m_handle = handle;
+
+    sWindowCommandReply reply;
+    PostAndWait(command, reply);
+    return reply.m_displayContext;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ThreadedWindowBackend::SetVisible(NativeWindowHandle const handle, bool const isVisible)
+{
+    sWindowCommand command;
+    command.m_op     = eWindowBackendOp::SET_VISIBLE;
+    command.m_handle = handle;
+    command.m_flag   = isVisible;
+    Post(command);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ThreadedWindowBackend::SetTitle(NativeWindowHandle const handle, String const& title)
+{
+    sWindowCommand command;
+    command.m_op     = eWindowBackendOp::SET_TITLE;
+    command.m_handle = handle;
+    command.m_title  = title;
+    Post(command);
+}
+
+//----------------------------------------------------------------------------------------------------
+// With a Window only the request is recorded, on the calling thread. The window thread never sees it.
+void ThreadedWindowBackend::SetClientPosition(NativeWindowHandle const handle, Window* window, Vec2 const& clientPosition)
+{
+    if (window != nullptr)
+    {
+        window->SetClientPosition(clientPosition);
+        return;
+    }
+
+    sWindowCommand command;
+    command.m_op     = eWindowBackendOp::SET_CLIENT_POSITION;
+    command.m_handle = handle;
+    command.m_value  = clientPosition;
+    Post(command);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ThreadedWindowBackend::SetClientDimensions(NativeWindowHandle const handle, Window* window, Vec2 const& clientDimensions)
+{
+    if (window != nullptr)
+    {
+        window->SetClientDimensions(clientDimensions);
+        return;
+    }
+
+    sWindowCommand command;
+    command.m_op     = eWindowBackendOp::SET_CLIENT_DIMENSIONS;
+    command.m_handle = handle;
+    command.m_value  = clientDimensions;
+    Post(command);
+}
+
+//----------------------------------------------------------------------------------------------------
+AABB2 ThreadedWindowBackend::GetClientRect(NativeWindowHandle const handle, Window* window)
+{
+    UNUSED(window)
+    CommandClock::time_point const start = CommandClock::now();
+
+    std::shared_ptr<sWindowGeometrySnapshot const> const snapshot = std::atomic_load(&m_publishedSnapshot);
+
+    auto const  it         = snapshot->m_clientRects.find(reinterpret_cast<uintptr_t>(handle));
+    AABB2 const clientRect = it != snapshot->m_clientRects.end() ? it->second : AABB2();
+
+    RecordOperation(eWindowBackendOp::QUERY_CLIENT_RECT, GetSecondsSince(start));
+    return clientRect;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ThreadedWindowBackend::QueryZOrder(std::vector<NativeWindowHandle> const& handles, std::vector<uint32_t>& out_zOrders)
+{
+    CommandClock::time_point const start = CommandClock::now();
+
+    std::shared_ptr<sWindowGeometrySnapshot const> const snapshot = std::atomic_load(&m_publishedSnapshot);
+
+    out_zOrders.resize(handles.size());
+    for (size_t handleIndex = 0; handleIndex < handles.size(); ++handleIndex)
+    {
+        auto const it            = snapshot->m_zOrders.find(reinterpret_cast<uintptr_t>(handles[handleIndex]));
+        out_zOrders[handleIndex] = it != snapshot->m_zOrders.end() ? it->second : UINT32_MAX;
+    }
+
+    RecordOperation(eWindowBackendOp::QUERY_Z_ORDER, GetSecondsSince(start));
+}
+
+//----------------------------------------------------------------------------------------------------
+void ThreadedWindowBackend::Flush()
+{
+    // COUNT is a no-op, the reply only comes back once everything queued before it has run
+    sWindowCommand      command;
+    sWindowCommandReply reply;
+    PostAndWait(command, reply);
+}
+
+//----------------------------------------------------------------------------------------------------
+sWindowThreadStats ThreadedWindowBackend::GetThreadStats() const
+{
+    std::shared_ptr<sWindowGeometrySnapshot const> const snapshot = std::atomic_load(&m_publishedSnapshot);
+
+    sWindowThreadStats stats    = m_producerStats;
+    stats.m_queueDepth          = m_queue.GetDepth();
+    stats.m_executedCount       = snapshot->m_executedCount;
+    stats.m_totalLatencySeconds = snapshot->m_totalLatencySeconds;
+    stats.m_maxLatencySeconds   = snapshot->m_maxLatencySeconds;
+    return stats;
+}
+
+//----------------------------------------------------------------------------------------------------
+void ThreadedWindowBackend::Post(sWindowCommand& command)
+{
+    CommandClock::time_point const start  = CommandClock::now();
+    eWindowBackendOp const         op     = command.m_op;
+    bool const                     isSync = command.m_reply != nullptr;
+
+    command.m_enqueueTime = start;
+
+    if (!m_queue.TryPush(command))
+    {
+        // 佇列滿了：叫醒視窗執行緒並讓出時間片，直到有空位
+        ++m_producerStats.m_queueFullStallCount;
+        do
+        {
+            m_wakeCondition.notify_one();
+            std::this_thread::yield();
+        }
+        while (!m_queue.TryPush(command));
+    }
+
+    m_wakeCondition.notify_one();
+
+    if (!isSync) ++m_producerStats.m_enqueuedCount;
+    m_producerStats.m_maxQueueDepth = std::max(m_producerStats.m_maxQueueDepth, m_queue.GetDepth());
+
+    if (op != eWindowBackendOp::COUNT) RecordOperation(op, GetSecondsSince(start));
+}
+
+//----------------------------------------------------------------------------------------------------
+void ThreadedWindowBackend::PostAndWait(sWindowCommand& command, sWindowCommandReply& reply)
+{
+    CommandClock::time_point const start = CommandClock::now();
+
+    command.m_reply = &reply;
+    Post(command);
+
+    while (!reply.m_isDone.load(std::memory_order_acquire))
+    {
+        std::this_thread::yield();
+    }
+
+    ++m_producerStats.m_syncCallCount;
+    m_producerStats.m_syncWaitSeconds += GetSecondsSince(start);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ThreadedWindowBackend::RunWindowThread()
+{
+    sWindowCommand command;
+
+    // Keep draining after shutdown is requested so no posted command is lost
+    while (m_isRunning.load(std::memory_order_acquire) || m_queue.GetDepth() > 0)
+    {
+        bool hasExecuted = false;
+
+        while (m_queue.TryPop(command))
+        {
+            sWindowCommandReply* reply = command.m_reply;
+            ExecuteCommand(command);
+            hasExecuted = true;
+
+            // Waiting callers may read geometry right away, so publish before releasing them
+            if (reply != nullptr)
+            {
+                RefreshGeometry();
+                PublishSnapshot();
+                hasExecuted = false;
+                reply->m_isDone.store(true, std::memory_order_release);
+            }
+        }
+
+        // The user can drag or raise windows without any command, so geometry is also re-read on a timer
+        bool const isRefreshDue = GetSecondsSince(m_workerLastRefreshTime) >= GEOMETRY_REFRESH_SECONDS;
+        if (isRefreshDue) RefreshGeometry();
+        if (hasExecuted || isRefreshDue) PublishSnapshot();
+
+        // Native windows created here only receive their messages on this thread
+        m_innerBackend.PumpMessages();
+
+        if (!hasExecuted)
+        {
+            std::unique_lock<std::mutex> lock(m_wakeMutex);
+            m_wakeCondition.wait_for(lock, std::chrono::milliseconds(1), [this] {
+                return !m_isRunning.load(std::memory_order_acquire) || m_queue.GetDepth() > 0;
+            });
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void ThreadedWindowBackend::ExecuteCommand(sWindowCommand& command)
+{
+    uintptr_t const handleValue = reinterpret_cast<uintptr_t>(command.m_handle);
+
+    switch (command.m_op)
+    {
+    case eWindowBackendOp::CREATE_WINDOW:
+        {
+            NativeWindowHandle const handle = m_innerBackend.CreateNativeWindow(command.m_title, command.m_createX, command.m_createY, command.m_createWidth, command.m_createHeight);
+            if (handle != nullptr) m_workerClientRects[reinterpret_cast<uintptr_t>(handle)] = m_innerBackend.GetClientRect(handle, nullptr);
+            command.m_reply->m_handle = handle;
+            break;
+        }
+    // The caller is blocked until this returns, so the Window is never touched by both threads at once
+    case eWindowBackendOp::DESTROY_WINDOW:
+        m_innerBackend.DestroyNativeWindow(command.m_handle, command.m_window);
+        m_workerClientRects.erase(handleValue);
+        m_workerZOrders.erase(handleValue);
+        break;
+    case eWindowBackendOp::ACQUIRE_DISPLAY_CONTEXT:
+        command.m_reply->m_displayContext = m_innerBackend.AcquireDisplayContext(command.m_handle);
+        break;
+    case eWindowBackendOp::SET_VISIBLE:
+        m_innerBackend.SetVisible(command.m_handle, command.m_flag);
+        m_workerLastRefreshTime = CommandClock::time_point();     // Showing a window raises it, re-rank this batch
+        break;
+    case eWindowBackendOp::SET_TITLE:
+        m_innerBackend.SetTitle(command.m_handle, command.m_title);
+        break;
+    case eWindowBackendOp::SET_CLIENT_POSITION:
+        m_innerBackend.SetClientPosition(command.m_handle, nullptr, command.m_value);
+        m_workerClientRects[handleValue] = m_innerBackend.GetClientRect(command.m_handle, nullptr);
+        break;
+    case eWindowBackendOp::SET_CLIENT_DIMENSIONS:
+        m_innerBackend.SetClientDimensions(command.m_handle, nullptr, command.m_value);
+        m_workerClientRects[handleValue] = m_innerBackend.GetClientRect(command.m_handle, nullptr);
+        break;
+    case eWindowBackendOp::QUERY_CLIENT_RECT:
+    case eWindowBackendOp::QUERY_Z_ORDER:
+    case eWindowBackendOp::COUNT:
+        break;
+    }
+
+    double const latencySeconds = GetSecondsSince(command.m_enqueueTime);
+    ++m_workerExecutedCount;
+    m_workerTotalLatencySeconds += latencySeconds;
+    m_workerMaxLatencySeconds = std::max(m_workerMaxLatencySeconds, latencySeconds);
+}
+
+//----------------------------------------------------------------------------------------------------
+void ThreadedWindowBackend::RefreshGeometry()
+{
+    m_workerLastRefreshTime = CommandClock::now();
+
+    m_workerHandles.clear();
+    for (auto& [handleValue, clientRect] : m_workerClientRects)
+    {
+        NativeWindowHandle const handle = reinterpret_cast<NativeWindowHandle>(handleValue);
+        clientRect                      = m_innerBackend.GetClientRect(handle, nullptr);
+        m_workerHandles.push_back(handle);
+    }
+
+    m_innerBackend.QueryZOrder(m_workerHandles, m_workerRanks);
+
+    m_workerZOrders.clear();
+    for (size_t handleIndex = 0; handleIndex < m_workerHandles.size(); ++handleIndex)
+    {
+        m_workerZOrders[reinterpret_cast<uintptr_t>(m_workerHandles[handleIndex])] = m_workerRanks[handleIndex];
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void ThreadedWindowBackend::PublishSnapshot()
+{
+    std::shared_ptr<sWindowGeometrySnapshot> snapshot = std::make_shared<sWindowGeometrySnapshot>();
+    snapshot->m_clientRects         = m_workerClientRects;
+    snapshot->m_zOrders             = m_workerZOrders;
+    snapshot->m_executedCount       = m_workerExecutedCount;
+    snapshot->m_totalLatencySeconds = m_workerTotalLatencySeconds;
+    snapshot->m_maxLatencySeconds   = m_workerMaxLatencySeconds;
+
+    std::atomic_store(&m_publishedSnapshot, std::shared_ptr<sWindowGeometrySnapshot const>(std::move(snapshot)));
+}
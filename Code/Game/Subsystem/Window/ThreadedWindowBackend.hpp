@@ -0,0 +1,113 @@
+//----------------------------------------------------------------------------------------------------
+// ThreadedWindowBackend.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "Game/Subsystem/Window/IWindowBackend.hpp"
+#include "Game/Subsystem/Window/WindowCommandQueue.hpp"
+
+//----------------------------------------------------------------------------------------------------
+struct sWindowThreadStats
+{
+    // Game thread side
+    uint64_t m_enqueuedCount       = 0;     // Fire-and-forget commands posted
+    uint64_t m_queueFullStallCount = 0;     // Pushes that had to wait for the window thread to make room
+    uint64_t m_syncCallCount       = 0;     // Create, destroy and DC calls the game thread waited on
+    double   m_syncWaitSeconds     = 0.0;
+    uint32_t m_queueDepth          = 0;     // Commands waiting when the stats were read
+    uint32_t m_maxQueueDepth       = 0;
+
+    // Window thread side, as of the last published snapshot
+    uint64_t m_executedCount       = 0;
+    double   m_totalLatencySeconds = 0.0;   // Enqueue to executed, summed over every command
+    double   m_maxLatencySeconds   = 0.0;
+
+    double GetAverageLatencySeconds() const { return m_executedCount > 0 ? m_totalLatencySeconds / static_cast<double>(m_executedCount) : 0.0; }
+};
+
+//----------------------------------------------------------------------------------------------------
+// Immutable geometry published by the window thread after every batch of commands it executes, and
+// at least every GEOMETRY_REFRESH_SECONDS while idle so drags and z-order changes made by the user show up.
+struct sWindowGeometrySnapshot
+{
+    std::unordered_map<uintptr_t, AABB2>    m_clientRects;  // Native handle -> client rect
+    std::unordered_map<uintptr_t, uint32_t> m_zOrders;      // Native handle -> rank, 0 is topmost
+    uint64_t                                m_executedCount       = 0;
+    double                                  m_totalLatencySeconds = 0.0;
+    double                                  m_maxLatencySeconds   = 0.0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Runs another backend on a dedicated window thread. Visibility, title, position and dimension changes
+// are posted to a lock-free SPSC queue and return immediately, so a busy OS stalls the window thread
+// instead of the frame. Creation, destruction and DC acquisition wait for the window thread, which
+// creates (and so owns and pumps messages for) every native window. GetClientRect and QueryZOrder
+// answer from the last published sWindowGeometrySnapshot and lag queued changes by up to one batch.
+//
+// The window thread only ever works on native handles. A geometry call that comes with an engine Window
+// just records the request in that Window on the calling thread; WindowSubsystem then posts the
+// resulting client rect by handle once per frame instead of calling Window::UpdatePosition. The one
+// exception is DestroyNativeWindow, which hands the Window to the window thread while the caller waits,
+// because only the thread that created a window and its DC may destroy or release them. Swap chains
+// still live on the game thread with the D3D immediate context, so resizes and presents stay there.
+//
+class ThreadedWindowBackend : public IWindowBackend
+{
+public:
+    ThreadedWindowBackend(IWindowBackend& innerBackend, uint32_t queueCapacity);
+    ~ThreadedWindowBackend() override;
+
+    bool               IsNative() const override;
+    NativeWindowHandle CreateNativeWindow(String const& title, int x, int y, int width, int height) override;
+    void               DestroyNativeWindow(NativeWindowHandle handle, Window* window) override;
+    void*              AcquireDisplayContext(NativeWindowHandle handle) override;
+    void               SetVisible(NativeWindowHandle handle, bool isVisible) override;
+    void               SetTitle(NativeWindowHandle handle, String const& title) override;
+    void               SetClientPosition(NativeWindowHandle handle, Window* window, Vec2 const& clientPosition) override;
+    void               SetClientDimensions(NativeWindowHandle handle, Window* window, Vec2 const& clientDimensions) override;
+    AABB2              GetClientRect(NativeWindowHandle handle, Window* window) override;
+    void               QueryZOrder(std::vector<NativeWindowHandle> const& handles, std::vector<uint32_t>& out_zOrders) override;
+
+    /// Blocks until the window thread has executed everything posted so far.
+    void               Flush();
+    sWindowThreadStats GetThreadStats() const;
+
+private:
+    void Post(sWindowCommand& command);
+    void PostAndWait(sWindowCommand& command, sWindowCommandReply& reply);
+    void RunWindowThread();
+    void ExecuteCommand(sWindowCommand& command);
+    void RefreshGeometry();
+    void PublishSnapshot();
+
+    IWindowBackend&    m_innerBackend;
+    WindowCommandQueue m_queue;
+
+    std::mutex              m_wakeMutex;            // Only used to sleep the window thread, never guards data
+    std::condition_variable m_wakeCondition;
+    std::atomic<bool>       m_isRunning{true};
+
+    // Game thread only
+    sWindowThreadStats m_producerStats;
+
+    // Window thread only
+    std::unordered_map<uintptr_t, AABB2>     m_workerClientRects;
+    std::unordered_map<uintptr_t, uint32_t>  m_workerZOrders;
+    std::vector<NativeWindowHandle>          m_workerHandles;   // Scratch for RefreshGeometry
+    std::vector<uint32_t>                    m_workerRanks;
+    sWindowCommand::CommandClock::time_point m_workerLastRefreshTime;
+    uint64_t                                 m_workerExecutedCount       = 0;
+    double                                   m_workerTotalLatencySeconds = 0.0;
+    double                                   m_workerMaxLatencySeconds   = 0.0;
+
+    std::shared_ptr<sWindowGeometrySnapshot const> m_publishedSnapshot;     // Swapped with std::atomic_store
+
+    std::thread m_windowThread;     // Last, so it starts after every member above is constructed
+};
@@ -0,0 +1,305 @@
+//----------------------------------------------------------------------------------------------------
+// Win32WindowBackend.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Window/Win32WindowBackend.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Platform/Window.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static std::wstring ToWideString(String const& text)
+{
+    std::wstring wText;
+    wText.resize(text.size());
+    int const length = MultiByteToWideChar(CP_UTF8, 0, text.c_str(), static_cast<int>(text.size()), wText.data(), static_cast<int>(wText.size()));
+    wText.resize(static_cast<size_t>(length > 0 ? length : 0));
+    return wText;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Moves or resizes a window by handle, for callers that have no engine Window. Client coordinates are
+// y-up like Window's, so a resize keeps the bottom-left corner of the client rect where it is.
+static void SetClientRectByHandle(HWND const hwnd, Vec2 const* clientPosition, Vec2 const* clientDimensions)
+{
+    RECT  clientRect = {};
+    POINT topLeft    = {0, 0};
+    if (!::GetClientRect(hwnd, &clientRect) || !ClientToScreen(hwnd, &topLeft)) return;
+
+    int const screenHeight = GetSystemMetrics(SM_CYSCREEN);
+    int const width        = clientDimensions ? static_cast<int>(clientDimensions->x) : clientRect.right - clientRect.left;
+    int const height       = clientDimensions ? static_cast<int>(clientDimensions->y) : clientRect.bottom - clientRect.top;
+    int const left         = clientPosition ? static_cast<int>(clientPosition->x) : topLeft.x;
+    int const bottom       = clientPosition ? screenHeight - static_cast<int>(clientPosition->y) : topLeft.y + clientRect.bottom - clientRect.top;
+
+    RECT windowRect = {left, bottom - height, left + width, bottom};
+    AdjustWindowRectEx(&windowRect, static_cast<DWORD>(GetWindowLong(hwnd, GWL_STYLE)), FALSE, static_cast<DWORD>(GetWindowLong(hwnd, GWL_EXSTYLE)));
+
+    UINT const flags = SWP_NOZORDER | SWP_NOACTIVATE | (clientDimensions ? 0 : SWP_NOSIZE);
+    SetWindowPos(hwnd, nullptr, windowRect.left, windowRect.top, windowRect.right - windowRect.left, windowRect.bottom - windowRect.top, flags);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Child windows owned by a window thread must not run the main window's procedure there, it feeds the
+// engine's input and event systems. Keys are posted on to the main window, whose queue the game thread
+// pumps. Closing is ignored because the game decides when child windows go away, the rest is default.
+static HWND s_inputTargetWindow = nullptr;
+
+static LRESULT CALLBACK WindowThreadChildWindowProc(HWND const hwnd, UINT const message, WPARAM const wParam, LPARAM const lParam)
+{
+    if (message >= WM_KEYFIRST && message <= WM_KEYLAST)
+    {
+        PostMessage(s_inputTargetWindow, message, wParam, lParam);
+        return 0;
+    }
+
+    if (message == WM_CLOSE) return 0;
+
+    return DefWindowProc(hwnd, message, wParam, lParam);
+}
+
+//----------------------------------------------------------------------------------------------------
+// Times one OS call and records it against its op when the scope ends.
+class Win32WindowBackend::ScopedOpTimer
+{
+public:
+    using OpClock = std::chrono::steady_clock;
+
+    explicit ScopedOpTimer(eWindowBackendOp const op, Win32WindowBackend& backend)
+        : m_op(op),
+          m_backend(backend),
+          m_start(OpClock::now())
+    {
+    }
+
+    ~ScopedOpTimer()
+    {
+        std::chrono::duration<double> const elapsed = OpClock::now() - m_start;
+        m_backend.RecordOperation(m_op, elapsed.count());
+    }
+
+private:
+    eWindowBackendOp    m_op;
+    Win32WindowBackend& m_backend;
+    OpClock::time_point m_start;
+};
+
+//----------------------------------------------------------------------------------------------------
+Win32WindowBackend::Win32WindowBackend(wchar_t const* iconFilePath, bool const isOnWindowThread)
+    : m_iconFilePath(iconFilePath),
+      m_isOnWindowThread(isOnWindowThread)
+{
+}
+
+//----------------------------------------------------------------------------------------------------
+bool Win32WindowBackend::IsNative() const
+{
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+NativeWindowHandle Win32WindowBackend::CreateNativeWindow(String const& title,
+                                                          int const     x,
+                                                          int const     y,
+                                                          int const     width,
+                                                          int const     height)
+{
+    ScopedOpTimer const timer(eWindowBackendOp::CREATE_WINDOW, *this);
+
+    // 轉換名稱為寬字符
+    std::wstring const wTitle = ToWideString(title);
+
+    // 註冊視窗類別（只需要註冊一次）
+    RegisterChildWindowClass();
+
+    // 調整視窗大小，確保客戶區域是指定的 width 和 height
+    RECT rect = {0, 0, width, height};
+    AdjustWindowRectEx(&rect, WS_OVERLAPPEDWINDOW, FALSE, 0);
+
+    int adjustedWidth  = rect.right - rect.left;
+    int adjustedHeight = rect.bottom - rect.top;
+
+    HWND hwnd = CreateWindowEx(
+        0,
+        L"ChildWindow",
+        wTitle.c_str(),
+        WS_OVERLAPPED | WS_CAPTION | WS_SYSMENU,
+        x, y, adjustedWidth, adjustedHeight,
+        nullptr,
+        nullptr,
+        GetModuleHandle(nullptr),
+        nullptr
+    );
+
+    return hwnd;
+}
+
+//----------------------------------------------------------------------------------------------------
+void Win32WindowBackend::DestroyNativeWindow(NativeWindowHandle const handle, Window* window)
+{
+    ScopedOpTimer const timer(eWindowBackendOp::DESTROY_WINDOW, *this);
+
+    if (window != nullptr)
+    {
+        window->Shutdown();
+    }
+    else if (handle != nullptr)
+    {
+        ::DestroyWindow(static_cast<HWND>(handle));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void* Win32WindowBackend::AcquireDisplayContext(NativeWindowHandle const handle)
+{
+    ScopedOpTimer const timer(eWindowBackendOp::ACQUIRE_DISPLAY_CONTEXT, *this);
+
+    return GetDC(static_cast<HWND>(handle));
+}
+
+//----------------------------------------------------------------------------------------------------
+void Win32WindowBackend::SetVisible(NativeWindowHandle const handle, bool const isVisible)
+{
+    ScopedOpTimer const timer(eWindowBackendOp::SET_VISIBLE, *this);
+
+    ShowWindow(static_cast<HWND>(handle), isVisible ? SW_SHOW : SW_HIDE);
+}
+
+//----------------------------------------------------------------------------------------------------
+void Win32WindowBackend::SetTitle(NativeWindowHandle const handle, String const& title)
+{
+    ScopedOpTimer const timer(eWindowBackendOp::SET_TITLE, *this);
+
+    SetWindowTextW(static_cast<HWND>(handle), ToWideString(title).c_str());
+}
+
+//----------------------------------------------------------------------------------------------------
+void Win32WindowBackend::SetClientPosition(NativeWindowHandle const handle, Window* window, Vec2 const& clientPosition)
+{
+    if (window == nullptr && handle == nullptr) return;
+
+    ScopedOpTimer const timer(eWindowBackendOp::SET_CLIENT_POSITION, *this);
+
+    if (window != nullptr)
+    {
+        window->SetClientPosition(clientPosition);
+        return;
+    }
+
+    SetClientRectByHandle(static_cast<HWND>(handle), &clientPosition, nullptr);
+}
+
+//----------------------------------------------------------------------------------------------------
+void Win32WindowBackend::SetClientDimensions(NativeWindowHandle const handle, Window* window, Vec2 const& clientDimensions)
+{
+    if (window == nullptr && handle == nullptr) return;
+
+    ScopedOpTimer const timer(eWindowBackendOp::SET_CLIENT_DIMENSIONS, *this);
+
+    if (window != nullptr)
+    {
+        window->SetClientDimensions(clientDimensions);
+        return;
+    }
+
+    SetClientRectByHandle(static_cast<HWND>(handle), nullptr, &clientDimensions);
+}
+
+//----------------------------------------------------------------------------------------------------
+AABB2 Win32WindowBackend::GetClientRect(NativeWindowHandle const handle, Window* window)
+{
+    if (window == nullptr && handle == nullptr) return AABB2();
+
+    ScopedOpTimer const timer(eWindowBackendOp::QUERY_CLIENT_RECT, *this);
+
+    if (window != nullptr)
+    {
+        Vec2 const clientPosition = window->GetClientPosition();
+        return AABB2(clientPosition, clientPosition + window->GetClientDimensions());
+    }
+
+    // 沒有 Window 時直接問作業系統，轉成與 Window 相同的 y 軸向上座標
+    HWND const hwnd       = static_cast<HWND>(handle);
+    RECT       clientRect = {};
+    POINT      topLeft    = {0, 0};
+    if (!::GetClientRect(hwnd, &clientRect) || !ClientToScreen(hwnd, &topLeft)) return AABB2();
+
+    float const screenHeight = static_cast<float>(GetSystemMetrics(SM_CYSCREEN));
+    float const width        = static_cast<float>(clientRect.right - clientRect.left);
+    float const height       = static_cast<float>(clientRect.bottom - clientRect.top);
+    Vec2 const  mins         = Vec2(static_cast<float>(topLeft.x), screenHeight - (static_cast<float>(topLeft.y) + height));
+    return AABB2(mins, mins + Vec2(width, height));
+}
+
+//----------------------------------------------------------------------------------------------------
+void Win32WindowBackend::PumpMessages()
+{
+    MSG message = {};
+    while (PeekMessage(&message, nullptr, 0, 0, PM_REMOVE))
+    {
+        TranslateMessage(&message);
+        DispatchMessage(&message);
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// Walks the top-level windows from the top of the desktop z-order down and stops once every requested
+// handle has been ranked. Ranks count all top-level windows, so only their relative order matters.
+void Win32WindowBackend::QueryZOrder(std::vector<NativeWindowHandle> const& handles, std::vector<uint32_t>& out_zOrders)
+{
+    ScopedOpTimer const timer(eWindowBackendOp::QUERY_Z_ORDER, *this);
+
+    out_zOrders.assign(handles.size(), UINT32_MAX);
+
+    std::vector<std::pair<HWND, size_t>> sortedHandles;
+    sortedHandles.reserve(handles.size());
+    for (size_t handleIndex = 0; handleIndex < handles.size(); ++handleIndex)
+    {
+        if (handles[handleIndex] != nullptr) sortedHandles.emplace_back(static_cast<HWND>(handles[handleIndex]), handleIndex);
+    }
+    std::sort(sortedHandles.begin(), sortedHandles.end());
+
+    size_t   remaining = sortedHandles.size();
+    uint32_t rank      = 0;
+
+    for (HWND hwnd = GetTopWindow(nullptr); hwnd != nullptr && remaining > 0; hwnd = GetWindow(hwnd, GW_HWNDNEXT), ++rank)
+    {
+        auto it = std::lower_bound(sortedHandles.begin(), sortedHandles.end(), std::make_pair(hwnd, size_t(0)));
+
+        for (; it != sortedHandles.end() && it->first == hwnd; ++it)
+        {
+            out_zOrders[it->second] = rank;
+            --remaining;
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void Win32WindowBackend::RegisterChildWindowClass()
+{
+    if (m_classRegistered) return;
+
+    HWND const mainWindow = (HWND)Window::s_mainWindow->GetWindowHandle();
+    s_inputTargetWindow   = mainWindow;
+
+    WNDCLASS wc      = {};
+    wc.lpfnWndProc   = m_isOnWindowThread ? WindowThreadChildWindowProc : (WNDPROC)GetWindowLongPtr(mainWindow, GWLP_WNDPROC);
+    wc.hInstance     = GetModuleHandle(nullptr);
+    wc.lpszClassName = L"ChildWindow";
+    wc.hbrBackground = (HBRUSH)(COLOR_WINDOW + 1);
+    wc.hCursor       = LoadCursor(nullptr, IDC_ARROW);
+    wc.hIcon         = (HICON)LoadImage(
+        NULL,
+        m_iconFilePath,
+        IMAGE_ICON,
+        32, 32,
+        LR_LOADFROMFILE
+    );
+    RegisterClass(&wc);
+    m_classRegistered = true;
+}
@@ -0,0 +1,37 @@
+//----------------------------------------------------------------------------------------------------
+// Win32WindowBackend.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include "Game/Subsystem/Window/IWindowBackend.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// isOnWindowThread registers child windows with a procedure that is safe to run off the game thread,
+// for use behind ThreadedWindowBackend.
+class Win32WindowBackend : public IWindowBackend
+{
+public:
+    explicit Win32WindowBackend(wchar_t const* iconFilePath, bool isOnWindowThread = false);
+
+    bool               IsNative() const override;
+    NativeWindowHandle CreateNativeWindow(String const& title, int x, int y, int width, int height) override;
+    void               DestroyNativeWindow(NativeWindowHandle handle, Window* window) override;
+    void*              AcquireDisplayContext(NativeWindowHandle handle) override;
+    void               SetVisible(NativeWindowHandle handle, bool isVisible) override;
+    void               SetTitle(NativeWindowHandle handle, String const& title) override;
+    void               SetClientPosition(NativeWindowHandle handle, Window* window, Vec2 const& clientPosition) override;
+    void               SetClientDimensions(NativeWindowHandle handle, Window* window, Vec2 const& clientDimensions) override;
+    AABB2              GetClientRect(NativeWindowHandle handle, Window* window) override;
+    void               QueryZOrder(std::vector<NativeWindowHandle> const& handles, std::vector<uint32_t>& out_zOrders) override;
+    void               PumpMessages() override;
+
+private:
+    class ScopedOpTimer;
+
+    void RegisterChildWindowClass();
+
+    wchar_t const* m_iconFilePath     = nullptr;
+    bool           m_isOnWindowThread = false;
+    bool           m_classRegistered  = false;
+};
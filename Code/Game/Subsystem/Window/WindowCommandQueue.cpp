@@ -0,0 +1,58 @@
+//----------------------------------------------------------------------------------------------------
+// WindowCommandQueue.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Window/WindowCommandQueue.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static uint32_t RoundUpToPowerOfTwo(uint32_t const value)
+{
+    uint32_t powerOfTwo = 1;
+    while (powerOfTwo < value) powerOfTwo <<= 1;
+    return powerOfTwo;
+}
+
+//----------------------------------------------------------------------------------------------------
+WindowCommandQueue::WindowCommandQueue(uint32_t const capacity)
+{
+    uint32_t const slotCount = RoundUpToPowerOfTwo(capacity > 1 ? capacity : 2);
+    m_slots.resize(slotCount);
+    m_mask = slotCount - 1;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool WindowCommandQueue::TryPush(sWindowCommand& command)
+{
+    uint32_t const tail = m_tail.load(std::memory_order_relaxed);
+    uint32_t const head = m_head.load(std::memory_order_acquire);
+    if (tail - head > m_mask) return false;
+
+    m_slots[tail & m_mask] = std::move(command);
+    m_tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool WindowCommandQueue::TryPop(sWindowCommand& out_command)
+{
+    uint32_t const head = m_head.load(std::memory_order_relaxed);
+    uint32_t const tail = m_tail.load(std::memory_order_acquire);
+    if (head == tail) return false;
+
+    out_command = std::move(m_slots[head & m_mask]);
+    m_head.store(head + 1, std::memory_order_release);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t WindowCommandQueue::GetDepth() const
+{
+    return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_acquire);
+}
+
+//----------------------------------------------------------------------------------------------------
+uint32_t WindowCommandQueue::GetCapacity() const
+{
+    return m_mask + 1;
+}
@@ -0,0 +1,72 @@
+//----------------------------------------------------------------------------------------------------
+// WindowCommandQueue.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "Game/Subsystem/Window/IWindowBackend.hpp"
+
+//----------------------------------------------------------------------------------------------------
+// Filled by the window thread for commands the game thread waits on.
+struct sWindowCommandReply
+{
+    std::atomic<bool>  m_isDone{false};
+    NativeWindowHandle m_handle         = nullptr;
+    void*              m_displayContext = nullptr;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sWindowCommand
+{
+    using CommandClock = std::chrono::steady_clock;
+
+    eWindowBackendOp         m_op           = eWindowBackendOp::COUNT;
+    NativeWindowHandle       m_handle       = nullptr;
+    Window*                  m_window       = nullptr;      // DESTROY_WINDOW only, see ThreadedWindowBackend
+    Vec2                     m_value        = Vec2::ZERO;   // Client position or dimensions
+    bool                     m_flag         = false;        // Visibility
+    String                   m_title;
+    int                      m_createX      = 0;
+    int                      m_createY      = 0;
+    int                      m_createWidth  = 0;
+    int                      m_createHeight = 0;
+    sWindowCommandReply*     m_reply        = nullptr;      // nullptr for fire-and-forget commands
+    CommandClock::time_point m_enqueueTime;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Bounded single-producer/single-consumer ring. The game thread is the only producer and the window
+// thread the only consumer, so a pair of monotonically increasing indices is all the synchronisation
+// needed: the producer publishes a slot with a release store of m_tail, the consumer frees it with a
+// release store of m_head. Slots are preallocated and reused, so steady state pushes do not allocate
+// (beyond a title string growing).
+//
+class WindowCommandQueue
+{
+public:
+    explicit WindowCommandQueue(uint32_t capacity);
+
+    WindowCommandQueue(WindowCommandQueue const&)            = delete;
+    WindowCommandQueue& operator=(WindowCommandQueue const&) = delete;
+
+    /// Producer only. Fails when the ring is full, command is left untouched in that case.
+    bool TryPush(sWindowCommand& command);
+
+    /// Consumer only.
+    bool TryPop(sWindowCommand& out_command);
+
+    uint32_t GetDepth() const;
+    uint32_t GetCapacity() const;
+
+private:
+    std::vector<sWindowCommand> m_slots;
+    uint32_t                    m_mask = 0;
+
+    alignas(64) std::atomic<uint32_t> m_head{0};     // Next slot to pop, written by the consumer
+    alignas(64) std::atomic<uint32_t> m_tail{0};     // Next slot to push, written by the producer
+};
@@ -0,0 +1,112 @@
+//----------------------------------------------------------------------------------------------------
+// WindowScenarios.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Window/WindowScenarios.hpp"
+
+#include <algorithm>
+
+#include "Engine/Core/EngineCommon.hpp"
+#include "Engine/Core/ErrorWarningAssert.hpp"
+#include "Engine/Math/MathUtils.hpp"
+#include "Game/Subsystem/Window/MockWindowBackend.hpp"
+#include "Game/Subsystem/Window/WindowSubsystem.hpp"
+
+//----------------------------------------------------------------------------------------------------
+sMotionPredictionScenarioResult RunMotionPredictionScenario(sMotionPredictionScenario const& scenario)
+{
+    MockWindowBackend backend;
+    backend.SetSimulatedMoveLatency(scenario.m_moveLatencyFrames);
+
+    sWindowSubsystemConfig config;
+    config.m_backend                   = &backend;
+    config.m_isMotionPredictionEnabled = scenario.m_isPredictionEnabled;
+
+    WindowSubsystem subsystem(config);
+    subsystem.StartUp();
+
+    Vec2           position = Vec2(400.f, 300.f);
+    WindowID const windowID = subsystem.CreateChildWindow(0, "MotionPredictionScenario", static_cast<int>(position.x), static_cast<int>(position.y), 200, 200);
+
+    // The subsystem keeps the handle to itself, the call log says which one the mock handed out
+    NativeWindowHandle handle = nullptr;
+    for (sMockWindowCall const& call : backend.GetCallLog())
+    {
+        if (call.m_op == eWindowBackendOp::CREATE_WINDOW) handle = reinterpret_cast<NativeWindowHandle>(call.m_handleValue);
+    }
+    backend.SetCallLogEnabled(false);
+    backend.ClearCallLog();
+
+    sMotionPredictionScenarioResult result;
+    if (windowID == 0 || handle == nullptr)
+    {
+        subsystem.ShutDown();
+        return result;
+    }
+
+    Vec2   velocity         = Vec2(scenario.m_speed, 0.f);
+    float  turnTimer        = 0.f;
+    double totalErrorPixels = 0.0;
+
+    for (uint32_t frameIndex = 0; frameIndex < scenario.m_frameCount; ++frameIndex)
+    {
+        subsystem.BeginFrame();
+
+        turnTimer += scenario.m_deltaSeconds;
+        if (turnTimer >= scenario.m_turnIntervalSeconds)
+        {
+            turnTimer -= scenario.m_turnIntervalSeconds;
+            velocity = -velocity;
+        }
+        position += velocity * scenario.m_deltaSeconds;
+
+        subsystem.RequestClientPosition(windowID, position, velocity);
+        subsystem.UpdateWindows(scenario.m_deltaSeconds);
+        subsystem.Render();
+
+        // Same observation point as SampleMotionPrediction: right after this frame's moves were issued
+        float const errorPixels = GetDistance2D(backend.GetClientRect(handle, nullptr).m_mins, position);
+        totalErrorPixels += errorPixels;
+        result.m_maxErrorPixels = std::max(result.m_maxErrorPixels, errorPixels);
+
+        subsystem.EndFrame();
+        backend.AdvanceSimulatedFrame();
+    }
+
+    result.m_meanErrorPixels = scenario.m_frameCount > 0 ? static_cast<float>(totalErrorPixels / scenario.m_frameCount) : 0.f;
+
+    if (scenario.m_isPredictionEnabled)
+    {
+        result.m_measuredLatencyFrames = subsystem.GetPredictionStats().m_applyLatencyFrames;
+        result.m_latencySampleCount    = subsystem.GetPredictionStats().m_latencySampleCount;
+    }
+
+    subsystem.ShutDown();
+    return result;
+}
+
+//----------------------------------------------------------------------------------------------------
+void RunMotionPredictionScenarios()
+{
+    DebuggerPrintf("Motion prediction scenario (MockWindowBackend, 600 px/s, reversing every 0.5 s, 240 frames at 60 Hz)\n");
+    DebuggerPrintf("  latency | off: mean / max error | on: mean / max error | measured latency\n");
+
+    for (uint32_t latencyFrames = 0; latencyFrames <= 3; ++latencyFrames)
+    {
+        sMotionPredictionScenario scenario;
+        scenario.m_moveLatencyFrames = latencyFrames;
+
+        scenario.m_isPredictionEnabled = false;
+        sMotionPredictionScenarioResult const unpredicted = RunMotionPredictionScenario(scenario);
+
+        scenario.m_isPredictionEnabled = true;
+        sMotionPredictionScenarioResult const predicted = RunMotionPredictionScenario(scenario);
+
+        DebuggerPrintf("  %u frames | %6.1f / %6.1f px | %6.1f / %6.1f px | %.2f frames (%llu samples)\n",
+                       latencyFrames,
+                       unpredicted.m_meanErrorPixels, unpredicted.m_maxErrorPixels,
+                       predicted.m_meanErrorPixels, predicted.m_maxErrorPixels,
+                       predicted.m_measuredLatencyFrames, static_cast<unsigned long long>(predicted.m_latencySampleCount));
+    }
+}
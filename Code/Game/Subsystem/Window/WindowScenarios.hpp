@@ -0,0 +1,38 @@
+//----------------------------------------------------------------------------------------------------
+// WindowScenarios.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+
+//----------------------------------------------------------------------------------------------------
+struct sMotionPredictionScenario
+{
+    uint32_t m_moveLatencyFrames   = 2;             // Passed to MockWindowBackend::SetSimulatedMoveLatency
+    uint32_t m_frameCount          = 240;
+    float    m_deltaSeconds        = 1.f / 60.f;
+    float    m_speed               = 600.f;         // Pixels per second
+    float    m_turnIntervalSeconds = 0.5f;          // The entity reverses direction this often
+    bool     m_isPredictionEnabled = true;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sMotionPredictionScenarioResult
+{
+    float    m_meanErrorPixels       = 0.f;     // Where the mock reports the window at Render against where its entity is
+    float    m_maxErrorPixels        = 0.f;
+    float    m_measuredLatencyFrames = 0.f;     // sWindowPredictionStats::m_applyLatencyFrames at the end, 0 with prediction off
+    uint64_t m_latencySampleCount    = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Scenarios run on their own WindowSubsystem over a MockWindowBackend, so they need no OS windows, renderer
+// or game and can be started at any time without touching g_theWindowSubsystem.
+//
+/// One window follows one entity that moves back and forth, while the mock applies every move
+/// m_moveLatencyFrames frames after it was issued.
+sMotionPredictionScenarioResult RunMotionPredictionScenario(sMotionPredictionScenario const& scenario);
+
+/// Runs the scenario with prediction off and on for latencies 0 to 3 frames and prints the results with DebuggerPrintf.
+void RunMotionPredictionScenarios();
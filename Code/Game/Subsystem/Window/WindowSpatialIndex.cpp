@@ -0,0 +1,455 @@
+//----------------------------------------------------------------------------------------------------
+// WindowSpatialIndex.cpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#include "Game/Subsystem/Window/WindowSpatialIndex.hpp"
+
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+
+#include "Engine/Core/EngineCommon.hpp"
+
+#if defined(_M_X64) || defined(__SSE2__)
+#include <emmintrin.h>
+#define WINDOW_SPATIAL_INDEX_USE_SSE2
+#endif
+
+//----------------------------------------------------------------------------------------------------
+static constexpr uint32_t INVALID_SPATIAL_ENTRY = UINT32_MAX;
+static constexpr uint32_t SIMD_LANE_COUNT       = 4;
+
+//----------------------------------------------------------------------------------------------------
+static uint32_t RoundUpToLaneCount(uint32_t const count)
+{
+    return (count + SIMD_LANE_COUNT - 1) & ~(SIMD_LANE_COUNT - 1);
+}
+
+//----------------------------------------------------------------------------------------------------
+WindowSpatialIndex::WindowSpatialIndex(float const cellSize)
+    : m_cellSize(cellSize > 1.f ? cellSize : 1.f),
+      m_gridCellSize(m_cellSize)
+{
+    m_cellStarts.assign(1, 0);
+}
+
+//----------------------------------------------------------------------------------------------------
+void WindowSpatialIndex::SetRect(WindowID const windowID, AABB2 const& rect)
+{
+    auto const it = m_entryByWindowID.find(windowID);
+
+    if (it == m_entryByWindowID.end())
+    {
+        m_entryByWindowID[windowID] = static_cast<uint32_t>(m_windowIDs.size());
+        m_windowIDs.push_back(windowID);
+        m_minXs.push_back(rect.m_mins.x);
+        m_minYs.push_back(rect.m_mins.y);
+        m_maxXs.push_back(rect.m_maxs.x);
+        m_maxYs.push_back(rect.m_maxs.y);
+        m_isDirty = true;
+        return;
+    }
+
+    // 位置與尺寸沒變就不需要重建格子
+    uint32_t const entryIndex = it->second;
+    if (m_minXs[entryIndex] == rect.m_mins.x && m_minYs[entryIndex] == rect.m_mins.y &&
+        m_maxXs[entryIndex] == rect.m_maxs.x && m_maxYs[entryIndex] == rect.m_maxs.y) return;
+
+    m_minXs[entryIndex] = rect.m_mins.x;
+    m_minYs[entryIndex] = rect.m_mins.y;
+    m_maxXs[entryIndex] = rect.m_maxs.x;
+    m_maxYs[entryIndex] = rect.m_maxs.y;
+    m_isDirty           = true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool WindowSpatialIndex::Remove(WindowID const windowID)
+{
+    auto const it = m_entryByWindowID.find(windowID);
+    if (it == m_entryByWindowID.end()) return false;
+
+    RemoveAt(it->second);
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void WindowSpatialIndex::Clear()
+{
+    m_windowIDs.clear();
+    m_minXs.clear();
+    m_minYs.clear();
+    m_maxXs.clear();
+    m_maxYs.clear();
+    m_entryByWindowID.clear();
+    m_isDirty = true;
+}
+
+//----------------------------------------------------------------------------------------------------
+void WindowSpatialIndex::Rebuild()
+{
+    if (!m_isDirty) return;
+
+    m_isDirty = false;
+    ++m_stats.m_rebuildCount;
+
+    m_cellEntries.clear();
+    m_cellMinXs.clear();
+    m_cellMinYs.clear();
+    m_cellMaxXs.clear();
+    m_cellMaxYs.clear();
+    m_queryStamps.assign(m_windowIDs.size(), 0);
+    m_queryStamp = 0;
+
+    if (m_windowIDs.empty())
+    {
+        m_gridCellsX = 0;
+        m_gridCellsY = 0;
+        m_cellStarts.assign(1, 0);
+        m_stats.m_cellCount = 0;
+        return;
+    }
+
+    // 格子只蓋住目前所有視窗的範圍，視窗分得太開時放大格子而不是增加格數
+    float const gridMinX = *std::min_element(m_minXs.begin(), m_minXs.end());
+    float const gridMinY = *std::min_element(m_minYs.begin(), m_minYs.end());
+    float const gridMaxX = *std::max_element(m_maxXs.begin(), m_maxXs.end());
+    float const gridMaxY = *std::max_element(m_maxYs.begin(), m_maxYs.end());
+    float const extentX  = std::max(gridMaxX - gridMinX, 0.f);
+    float const extentY  = std::max(gridMaxY - gridMinY, 0.f);
+
+    m_gridMinX     = gridMinX;
+    m_gridMinY     = gridMinY;
+    m_gridCellSize = std::max({m_cellSize, extentX / MAX_CELLS_PER_AXIS, extentY / MAX_CELLS_PER_AXIS});
+    m_gridCellsX   = std::clamp(static_cast<uint32_t>(std::ceil(extentX / m_gridCellSize)), 1u, MAX_CELLS_PER_AXIS);
+    m_gridCellsY   = std::clamp(static_cast<uint32_t>(std::ceil(extentY / m_gridCellSize)), 1u, MAX_CELLS_PER_AXIS);
+
+    uint32_t const cellCount = m_gridCellsX * m_gridCellsY;
+    m_stats.m_cellCount      = cellCount;
+    m_stats.m_cellSize       = m_gridCellSize;
+
+    auto const toCellX = [this](float const x) { return std::min(static_cast<uint32_t>(std::max((x - m_gridMinX) / m_gridCellSize, 0.f)), m_gridCellsX - 1); };
+    auto const toCellY = [this](float const y) { return std::min(static_cast<uint32_t>(std::max((y - m_gridMinY) / m_gridCellSize, 0.f)), m_gridCellsY - 1); };
+
+    // Counting sort: count each cell, pad it to the SIMD width, then fill
+    m_cellStarts.assign(cellCount + 1, 0);
+    for (uint32_t entryIndex = 0; entryIndex < static_cast<uint32_t>(m_windowIDs.size()); ++entryIndex)
+    {
+        for (uint32_t cellY = toCellY(m_minYs[entryIndex]); cellY <= toCellY(m_maxYs[entryIndex]); ++cellY)
+        {
+            for (uint32_t cellX = toCellX(m_minXs[entryIndex]); cellX <= toCellX(m_maxXs[entryIndex]); ++cellX)
+            {
+                ++m_cellStarts[cellY * m_gridCellsX + cellX + 1];
+            }
+        }
+    }
+
+    for (uint32_t cellIndex = 0; cellIndex < cellCount; ++cellIndex)
+    {
+        m_cellStarts[cellIndex + 1] = m_cellStarts[cellIndex] + RoundUpToLaneCount(m_cellStarts[cellIndex + 1]);
+    }
+
+    // Padding lanes are inverted rects, which fail every overlap and distance test
+    uint32_t const paddedCount = m_cellStarts[cellCount];
+    m_cellEntries.assign(paddedCount, INVALID_SPATIAL_ENTRY);
+    m_cellMinXs.assign(paddedCount, FLT_MAX);
+    m_cellMinYs.assign(paddedCount, FLT_MAX);
+    m_cellMaxXs.assign(paddedCount, -FLT_MAX);
+    m_cellMaxYs.assign(paddedCount, -FLT_MAX);
+
+    std::vector<uint32_t> cellCursors(m_cellStarts.begin(), m_cellStarts.end() - 1);
+
+    for (uint32_t entryIndex = 0; entryIndex < static_cast<uint32_t>(m_windowIDs.size()); ++entryIndex)
+    {
+        for (uint32_t cellY = toCellY(m_minYs[entryIndex]); cellY <= toCellY(m_maxYs[entryIndex]); ++cellY)
+        {
+            for (uint32_t cellX = toCellX(m_minXs[entryIndex]); cellX <= toCellX(m_maxXs[entryIndex]); ++cellX)
+            {
+                uint32_t const slot = cellCursors[cellY * m_gridCellsX + cellX]++;
+                m_cellEntries[slot] = entryIndex;
+                m_cellMinXs[slot]   = m_minXs[entryIndex];
+                m_cellMinYs[slot]   = m_minYs[entryIndex];
+                m_cellMaxXs[slot]   = m_maxXs[entryIndex];
+                m_cellMaxYs[slot]   = m_maxYs[entryIndex];
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+bool WindowSpatialIndex::IsDirty() const
+{
+    return m_isDirty;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool WindowSpatialIndex::Contains(WindowID const windowID) const
+{
+    return m_entryByWindowID.find(windowID) != m_entryByWindowID.end();
+}
+
+//----------------------------------------------------------------------------------------------------
+void WindowSpatialIndex::QueryPoint(Vec2 const& point, std::vector<WindowID>& out_windowIDs) const
+{
+    QueryDisc(point, 0.f, out_windowIDs);
+}
+
+//----------------------------------------------------------------------------------------------------
+void WindowSpatialIndex::QueryDisc(Vec2 const& center, float const radius, std::vector<WindowID>& out_windowIDs) const
+{
+    sQueryShape shape;
+    shape.m_minX          = center.x - radius;
+    shape.m_minY          = center.y - radius;
+    shape.m_maxX          = center.x + radius;
+    shape.m_maxY          = center.y + radius;
+    shape.m_centerX       = center.x;
+    shape.m_centerY       = center.y;
+    shape.m_radiusSquared = radius * radius;
+    shape.m_isDisc        = true;
+
+    out_windowIDs.clear();
+    Query(shape, out_windowIDs);
+}
+
+//----------------------------------------------------------------------------------------------------
+void WindowSpatialIndex::QueryRect(AABB2 const& rect, std::vector<WindowID>& out_windowIDs) const
+{
+    sQueryShape shape;
+    shape.m_minX = rect.m_mins.x;
+    shape.m_minY = rect.m_mins.y;
+    shape.m_maxX = rect.m_maxs.x;
+    shape.m_maxY = rect.m_maxs.y;
+
+    out_windowIDs.clear();
+    Query(shape, out_windowIDs);
+}
+
+//----------------------------------------------------------------------------------------------------
+void WindowSpatialIndex::QueryDiscs(sConstSpan<Vec2> const& centers,
+                                    float const             radius,
+                                    std::vector<WindowID>&  out_windowIDs,
+                                    std::vector<uint32_t>&  out_offsets) const
+{
+    out_windowIDs.clear();
+    out_offsets.clear();
+    out_offsets.reserve(centers.size() + 1);
+    out_offsets.push_back(0);
+
+    for (Vec2 const& center : centers)
+    {
+        sQueryShape shape;
+        shape.m_minX          = center.x - radius;
+        shape.m_minY          = center.y - radius;
+        shape.m_maxX          = center.x + radius;
+        shape.m_maxY          = center.y + radius;
+        shape.m_centerX       = center.x;
+        shape.m_centerY       = center.y;
+        shape.m_radiusSquared = radius * radius;
+        shape.m_isDisc        = true;
+
+        Query(shape, out_windowIDs);
+        out_offsets.push_back(static_cast<uint32_t>(out_windowIDs.size()));
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t WindowSpatialIndex::GetCount() const
+{
+    return m_windowIDs.size();
+}
+
+//----------------------------------------------------------------------------------------------------
+sWindowSpatialIndexStats const& WindowSpatialIndex::GetStats() const
+{
+    return m_stats;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Returns a bit per rect in [0, 4) that the shape touches. Rects are closed on every side.
+static uint32_t TestRectBlock(float const* minXs,
+                              float const* minYs,
+                              float const* maxXs,
+                              float const* maxYs,
+                              float const  queryMinX,
+                              float const  queryMinY,
+                              float const  queryMaxX,
+                              float const  queryMaxY,
+                              float const  centerX,
+                              float const  centerY,
+                              float const  radiusSquared,
+                              bool const   isDisc)
+{
+#if defined(WINDOW_SPATIAL_INDEX_USE_SSE2)
+    __m128 const rectMinX = _mm_loadu_ps(minXs);
+    __m128 const rectMinY = _mm_loadu_ps(minYs);
+    __m128 const rectMaxX = _mm_loadu_ps(maxXs);
+    __m128 const rectMaxY = _mm_loadu_ps(maxYs);
+
+    if (isDisc)
+    {
+        // Distance from the center to the closest point of each rect
+        __m128 const cx = _mm_set1_ps(centerX);
+        __m128 const cy = _mm_set1_ps(centerY);
+        __m128 const dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(rectMinX, cx), _mm_sub_ps(cx, rectMaxX)), _mm_setzero_ps());
+        __m128 const dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(rectMinY, cy), _mm_sub_ps(cy, rectMaxY)), _mm_setzero_ps());
+        __m128 const d2 = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        return static_cast<uint32_t>(_mm_movemask_ps(_mm_cmple_ps(d2, _mm_set1_ps(radiusSquared))));
+    }
+
+    __m128 const overlapX = _mm_and_ps(_mm_cmple_ps(rectMinX, _mm_set1_ps(queryMaxX)), _mm_cmpge_ps(rectMaxX, _mm_set1_ps(queryMinX)));
+    __m128 const overlapY = _mm_and_ps(_mm_cmple_ps(rectMinY, _mm_set1_ps(queryMaxY)), _mm_cmpge_ps(rectMaxY, _mm_set1_ps(queryMinY)));
+    return static_cast<uint32_t>(_mm_movemask_ps(_mm_and_ps(overlapX, overlapY)));
+#else
+    uint32_t hitMask = 0;
+
+    for (uint32_t lane = 0; lane < SIMD_LANE_COUNT; ++lane)
+    {
+        bool isHit;
+        if (isDisc)
+        {
+            float const dx = std::max({minXs[lane] - centerX, centerX - maxXs[lane], 0.f});
+            float const dy = std::max({minYs[lane] - centerY, centerY - maxYs[lane], 0.f});
+            isHit          = dx * dx + dy * dy <= radiusSquared;
+        }
+        else
+        {
+            isHit = minXs[lane] <= queryMaxX && maxXs[lane] >= queryMinX && minYs[lane] <= queryMaxY && maxYs[lane] >= queryMinY;
+        }
+        if (isHit) hitMask |= 1u << lane;
+    }
+
+    return hitMask;
+#endif
+}
+
+//----------------------------------------------------------------------------------------------------
+void WindowSpatialIndex::Query(sQueryShape const& shape, std::vector<WindowID>& out_windowIDs) const
+{
+    ++m_stats.m_queryCount;
+
+    if (m_isDirty)
+    {
+        QueryBruteForce(shape, out_windowIDs);
+        return;
+    }
+
+    if (m_gridCellsX == 0) return;
+
+    float const gridMaxX = m_gridMinX + m_gridCellSize * static_cast<float>(m_gridCellsX);
+    float const gridMaxY = m_gridMinY + m_gridCellSize * static_cast<float>(m_gridCellsY);
+    if (shape.m_maxX < m_gridMinX || shape.m_maxY < m_gridMinY || shape.m_minX > gridMaxX || shape.m_minY > gridMaxY) return;
+
+    auto const toCellX = [this](float const x) { return std::min(static_cast<uint32_t>(std::max((x - m_gridMinX) / m_gridCellSize, 0.f)), m_gridCellsX - 1); };
+    auto const toCellY = [this](float const y) { return std::min(static_cast<uint32_t>(std::max((y - m_gridMinY) / m_gridCellSize, 0.f)), m_gridCellsY - 1); };
+
+    if (++m_queryStamp == 0)
+    {
+        std::fill(m_queryStamps.begin(), m_queryStamps.end(), 0);
+        m_queryStamp = 1;
+    }
+
+    for (uint32_t cellY = toCellY(shape.m_minY); cellY <= toCellY(shape.m_maxY); ++cellY)
+    {
+        for (uint32_t cellX = toCellX(shape.m_minX); cellX <= toCellX(shape.m_maxX); ++cellX)
+        {
+            uint32_t const cellIndex = cellY * m_gridCellsX + cellX;
+            uint32_t const cellEnd   = m_cellStarts[cellIndex + 1];
+
+            for (uint32_t blockStart = m_cellStarts[cellIndex]; blockStart < cellEnd; blockStart += SIMD_LANE_COUNT)
+            {
+                m_stats.m_rectTestCount += SIMD_LANE_COUNT;
+
+                uint32_t hitMask = TestRectBlock(&m_cellMinXs[blockStart], &m_cellMinYs[blockStart], &m_cellMaxXs[blockStart], &m_cellMaxYs[blockStart],
+                                                 shape.m_minX, shape.m_minY, shape.m_maxX, shape.m_maxY,
+                                                 shape.m_centerX, shape.m_centerY, shape.m_radiusSquared, shape.m_isDisc);
+
+                for (uint32_t lane = 0; hitMask != 0; ++lane, hitMask >>= 1)
+                {
+                    if ((hitMask & 1u) == 0) continue;
+
+                    uint32_t const entryIndex = m_cellEntries[blockStart + lane];
+                    if (m_queryStamps[entryIndex] == m_queryStamp) continue;
+
+                    m_queryStamps[entryIndex] = m_queryStamp;
+                    out_windowIDs.push_back(m_windowIDs[entryIndex]);
+                }
+            }
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void WindowSpatialIndex::QueryBruteForce(sQueryShape const& shape, std::vector<WindowID>& out_windowIDs) const
+{
+    ++m_stats.m_bruteForceCount;
+
+    uint32_t const entryCount = static_cast<uint32_t>(m_windowIDs.size());
+    uint32_t       blockStart = 0;
+
+    for (; blockStart + SIMD_LANE_COUNT <= entryCount; blockStart += SIMD_LANE_COUNT)
+    {
+        m_stats.m_rectTestCount += SIMD_LANE_COUNT;
+
+        uint32_t hitMask = TestRectBlock(&m_minXs[blockStart], &m_minYs[blockStart], &m_maxXs[blockStart], &m_maxYs[blockStart],
+                                         shape.m_minX, shape.m_minY, shape.m_maxX, shape.m_maxY,
+                                         shape.m_centerX, shape.m_centerY, shape.m_radiusSquared, shape.m_isDisc);
+
+        for (uint32_t lane = 0; hitMask != 0; ++lane, hitMask >>= 1)
+        {
+            if ((hitMask & 1u) != 0) out_windowIDs.push_back(m_windowIDs[blockStart + lane]);
+        }
+    }
+
+    // Tail: copy the last few rects into a padded block
+    if (blockStart < entryCount)
+    {
+        float minXs[SIMD_LANE_COUNT] = {FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX};
+        float minYs[SIMD_LANE_COUNT] = {FLT_MAX, FLT_MAX, FLT_MAX, FLT_MAX};
+        float maxXs[SIMD_LANE_COUNT] = {-FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX};
+        float maxYs[SIMD_LANE_COUNT] = {-FLT_MAX, -FLT_MAX, -FLT_MAX, -FLT_MAX};
+
+        for (uint32_t lane = 0; blockStart + lane < entryCount; ++lane)
+        {
+            minXs[lane] = m_minXs[blockStart + lane];
+            minYs[lane] = m_minYs[blockStart + lane];
+            maxXs[lane] = m_maxXs[blockStart + lane];
+            maxYs[lane] = m_maxYs[blockStart + lane];
+        }
+
+        m_stats.m_rectTestCount += SIMD_LANE_COUNT;
+
+        uint32_t hitMask = TestRectBlock(minXs, minYs, maxXs, maxYs,
+                                         shape.m_minX, shape.m_minY, shape.m_maxX, shape.m_maxY,
+                                         shape.m_centerX, shape.m_centerY, shape.m_radiusSquared, shape.m_isDisc);
+
+        for (uint32_t lane = 0; hitMask != 0; ++lane, hitMask >>= 1)
+        {
+            if ((hitMask & 1u) != 0) out_windowIDs.push_back(m_windowIDs[blockStart + lane]);
+        }
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+void WindowSpatialIndex::RemoveAt(uint32_t const entryIndex)
+{
+    m_entryByWindowID.erase(m_windowIDs[entryIndex]);
+
+    uint32_t const lastIndex = static_cast<uint32_t>(m_windowIDs.size() - 1);
+    if (entryIndex != lastIndex)
+    {
+        m_windowIDs[entryIndex] = m_windowIDs[lastIndex];
+        m_minXs[entryIndex]     = m_minXs[lastIndex];
+        m_minYs[entryIndex]     = m_minYs[lastIndex];
+        m_maxXs[entryIndex]     = m_maxXs[lastIndex];
+        m_maxYs[entryIndex]     = m_maxYs[lastIndex];
+
+        m_entryByWindowID[m_windowIDs[entryIndex]] = entryIndex;
+    }
+
+    m_windowIDs.pop_back();
+    m_minXs.pop_back();
+    m_minYs.pop_back();
+    m_maxXs.pop_back();
+    m_maxYs.pop_back();
+    m_isDirty = true;
+}
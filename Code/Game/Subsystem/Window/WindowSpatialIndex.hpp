@@ -0,0 +1,105 @@
+//----------------------------------------------------------------------------------------------------
+// WindowSpatialIndex.hpp
+//----------------------------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------------------------
+#pragma once
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Engine/Math/AABB2.hpp"
+#include "Engine/Math/Vec2.hpp"
+#include "Game/Framework/GameCommon.hpp"
+
+//----------------------------------------------------------------------------------------------------
+struct sWindowSpatialIndexStats
+{
+    uint64_t m_rebuildCount    = 0;
+    uint64_t m_queryCount      = 0;
+    uint64_t m_rectTestCount   = 0;     // Rects tested by queries, including SIMD padding lanes
+    uint64_t m_bruteForceCount = 0;     // Queries answered from the flat arrays because the grid was stale
+    uint32_t m_cellCount       = 0;
+    float    m_cellSize        = 0.f;   // Cell size of the current grid, grows when windows spread far apart
+};
+
+//----------------------------------------------------------------------------------------------------
+// Uniform grid over child window rects in client coordinates (y-up). SetRect/Remove only touch flat
+// per-window arrays and mark the grid dirty; Rebuild() rebins everything in one counting-sort pass.
+// Every cell stores copies of its rects as structure-of-arrays padded to four, so queries test four
+// rects per SSE instruction on contiguous memory.
+//
+// Point and disc queries treat rects as closed, so a window touching the query counts as a hit.
+// A query made while the grid is dirty falls back to testing every window, it never misses one.
+//
+class WindowSpatialIndex
+{
+public:
+    static constexpr uint32_t MAX_CELLS_PER_AXIS = 64;
+
+    explicit WindowSpatialIndex(float cellSize = 256.f);
+
+    void SetRect(WindowID windowID, AABB2 const& rect);
+    bool Remove(WindowID windowID);
+    void Clear();
+    void Rebuild();
+    bool IsDirty() const;
+    bool Contains(WindowID windowID) const;
+
+    void QueryPoint(Vec2 const& point, std::vector<WindowID>& out_windowIDs) const;
+    void QueryDisc(Vec2 const& center, float radius, std::vector<WindowID>& out_windowIDs) const;
+    void QueryRect(AABB2 const& rect, std::vector<WindowID>& out_windowIDs) const;
+
+    /// Runs one disc query per center. Hits for centers[i] are out_windowIDs[out_offsets[i], out_offsets[i + 1]).
+    void QueryDiscs(sConstSpan<Vec2> const& centers, float radius, std::vector<WindowID>& out_windowIDs, std::vector<uint32_t>& out_offsets) const;
+
+    size_t                          GetCount() const;
+    sWindowSpatialIndexStats const& GetStats() const;
+
+private:
+    struct sQueryShape
+    {
+        float m_minX          = 0.f;    // Bounds of the query
+        float m_minY          = 0.f;
+        float m_maxX          = 0.f;
+        float m_maxY          = 0.f;
+        float m_centerX       = 0.f;    // Disc only
+        float m_centerY       = 0.f;
+        float m_radiusSquared = 0.f;
+        bool  m_isDisc        = false;
+    };
+
+    void Query(sQueryShape const& shape, std::vector<WindowID>& out_windowIDs) const;
+    void QueryBruteForce(sQueryShape const& shape, std::vector<WindowID>& out_windowIDs) const;
+    void RemoveAt(uint32_t entryIndex);
+
+    float m_cellSize = 256.f;
+    bool  m_isDirty  = false;
+
+    // One entry per indexed window, swap-removed
+    std::vector<WindowID>                  m_windowIDs;
+    std::vector<float>                     m_minXs;
+    std::vector<float>                     m_minYs;
+    std::vector<float>                     m_maxXs;
+    std::vector<float>                     m_maxYs;
+    std::unordered_map<WindowID, uint32_t> m_entryByWindowID;
+
+    // Grid, cell c owns [m_cellStarts[c], m_cellStarts[c + 1]) of the m_cell* arrays
+    float                 m_gridMinX     = 0.f;
+    float                 m_gridMinY     = 0.f;
+    float                 m_gridCellSize = 256.f;
+    uint32_t              m_gridCellsX   = 0;
+    uint32_t              m_gridCellsY   = 0;
+    std::vector<uint32_t> m_cellStarts;
+    std::vector<uint32_t> m_cellEntries;    // Entry index, or UINT32_MAX for padding
+    std::vector<float>    m_cellMinXs;
+    std::vector<float>    m_cellMinYs;
+    std::vector<float>    m_cellMaxXs;
+    std::vector<float>    m_cellMaxYs;
+
+    // A window spanning several cells is reported once per query
+    mutable std::vector<uint32_t> m_queryStamps;
+    mutable uint32_t              m_queryStamp = 0;
+
+    mutable sWindowSpatialIndexStats m_stats;
+};
@@ -5,17 +5,155 @@
 //----------------------------------------------------------------------------------------------------
 #include "Game/Subsystem/Window/WindowSubsystem.hpp"
 
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
 #include <dxgi1_2.h>
 
 #include "Engine/Core/Clock.hpp"
 #include "Engine/Core/ErrorWarningAssert.hpp"
 #include "Engine/Input/InputSystem.hpp"
 #include "Game/Gameplay/Game.hpp"
+#include "Game/Subsystem/Window/Win32WindowBackend.hpp"
+
+//----------------------------------------------------------------------------------------------------
+static uint8_t GetFieldBit(eWindowStateField const field)
+{
+    return static_cast<uint8_t>(1u << static_cast<int>(field));
+}
+
+//----------------------------------------------------------------------------------------------------
+// Sub-pixel moves never reach the OS, so requests are compared on whole pixels.
+static Vec2 QuantizeToPixel(Vec2 const& value)
+{
+    return Vec2(static_cast<float>(RoundDownToInt(value.x + 0.5f)), static_cast<float>(RoundDownToInt(value.y + 0.5f)));
+}
+
+//----------------------------------------------------------------------------------------------------
+static uint64_t MakePoolBucketKey(int const width, int const height)
+{
+    return (static_cast<uint64_t>(static_cast<uint32_t>(width)) << 32) | static_cast<uint32_t>(height);
+}
+
+//----------------------------------------------------------------------------------------------------
+static uint32_t GetSlotIndex(WindowID const windowID)
+{
+    return windowID & WINDOW_ID_INDEX_MASK;
+}
+
+//----------------------------------------------------------------------------------------------------
+static uint32_t GetGeneration(WindowID const windowID)
+{
+    return windowID >> WINDOW_ID_INDEX_BITS;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Monotonic seconds for present timing, unaffected by the game clock being paused or scaled.
+static double GetPresentClockSeconds()
+{
+    using PresentClock = std::chrono::steady_clock;
+    static PresentClock::time_point const s_startTime = PresentClock::now();
+
+    std::chrono::duration<double> const elapsed = PresentClock::now() - s_startTime;
+    return elapsed.count();
+}
+
+//----------------------------------------------------------------------------------------------------
+bool sWindowOwnerList::Add(EntityID const entityID)
+{
+    if (Contains(entityID)) return false;
+
+    if (m_overflow.empty() && m_count < INLINE_CAPACITY)
+    {
+        m_inline[m_count] = entityID;
+    }
+    else
+    {
+        // 第一次超出內嵌容量時，把內嵌的 owner 一起搬到 heap，保持連續
+        if (m_overflow.empty()) m_overflow.assign(m_inline, m_inline + m_count);
+        m_overflow.push_back(entityID);
+    }
+
+    ++m_count;
+    return true;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool sWindowOwnerList::Remove(EntityID const entityID)
+{
+    EntityID* data = GetData();
+
+    for (uint32_t ownerIndex = 0; ownerIndex < m_count; ++ownerIndex)
+    {
+        if (data[ownerIndex] != entityID) continue;
+
+        data[ownerIndex] = data[m_count - 1];
+        --m_count;
+
+        if (!m_overflow.empty())
+        {
+            m_overflow.pop_back();
+
+            if (m_count <= INLINE_CAPACITY)
+            {
+                std::copy(m_overflow.begin(), m_overflow.end(), m_inline);
+                m_overflow.clear();
+            }
+        }
+        return true;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------------------------------------
+bool sWindowOwnerList::Contains(EntityID const entityID) const
+{
+    return std::find(begin(), end(), entityID) != end();
+}
+
+//----------------------------------------------------------------------------------------------------
+// Client rect in top-left origin screen pixels, the layout of the readback data. Window reports y-up.
+static sPixelRect GetClientPixelRect(AABB2 const& clientRect, float const screenHeight)
+{
+    Vec2 const clientPosition   = QuantizeToPixel(clientRect.m_mins);
+    Vec2 const clientDimensions = QuantizeToPixel(clientRect.m_maxs - clientRect.m_mins);
+
+    sPixelRect pixelRect;
+    pixelRect.m_minX = static_cast<int>(clientPosition.x);
+    pixelRect.m_maxX = static_cast<int>(clientPosition.x + clientDimensions.x);
+    pixelRect.m_minY = static_cast<int>(screenHeight - (clientPosition.y + clientDimensions.y));
+    pixelRect.m_maxY = static_cast<int>(screenHeight - clientPosition.y);
+    return pixelRect;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Largest edge displacement between two rects, so both moves and resizes count.
+static int GetPixelRectMoveDistance(sPixelRect const& from, sPixelRect const& to)
+{
+    return std::max({std::abs(to.m_minX - from.m_minX), std::abs(to.m_minY - from.m_minY), std::abs(to.m_maxX - from.m_maxX), std::abs(to.m_maxY - from.m_maxY)});
+}
 
 //----------------------------------------------------------------------------------------------------
 WindowSubsystem::WindowSubsystem(sWindowSubsystemConfig const& config)
-    : m_config(config)
+    : m_config(config),
+      m_backend(config.m_backend),
+      m_windowSpatialIndex(config.m_spatialIndexCellSize)
 {
+    m_predictionStats.m_applyLatencyFrames = m_config.m_initialApplyLatencyFrames;
+
+    if (m_backend == nullptr)
+    {
+        m_ownedBackend = std::make_unique<Win32WindowBackend>(m_config.m_iconFilePath, m_config.m_useWindowThread);
+        m_backend      = m_ownedBackend.get();
+    }
+
+    // 視窗執行緒模式：作業系統呼叫改由 ThreadedWindowBackend 轉送到專用執行緒，Window 只在遊戲執行緒上讀寫
+    if (m_config.m_useWindowThread)
+    {
+        m_threadedBackend = std::make_unique<ThreadedWindowBackend>(*m_backend, m_config.m_windowCommandQueueCapacity);
+        m_backend         = m_threadedBackend.get();
+    }
 }
 
 void WindowSubsystem::StartUp()
@@ -25,50 +163,91 @@ void WindowSubsystem::StartUp()
 
 void WindowSubsystem::BeginFrame()
 {
+    for (int fieldIndex = 0; fieldIndex < sWindowReconcileStats::FIELD_COUNT; ++fieldIndex)
+    {
+        m_reconcileStats.m_frameRequested[fieldIndex] = 0;
+        m_reconcileStats.m_frameIssued[fieldIndex]    = 0;
+    }
+
+    m_budgetStats.m_frameEvictionCount      = 0;
+    m_budgetStats.m_frameRematerializeCount = 0;
 }
 
 void WindowSubsystem::Update()
 {
-    if (g_theGame->GetCurrentGameState() == eGameState::SHOP || g_theGame->GetCurrentGameState() == eGameState::ATTRACT) return;
-    float const deltaSeconds = static_cast<float>(g_theGame->GetGameClock()->GetDeltaSeconds());
+    if (g_theGame->GetCurrentGameState() == eGameState::SHOP || g_theGame->GetCurrentGameState() == eGameState::ATTRACT)
+    {
+        // 視窗不會動，但商店與主選單仍要讀這一幀的視窗幾何
+        ++m_predictionFrameIndex;
+        CaptureWindowGeometry();
+        return;
+    }
+
+    UpdateWindows(static_cast<float>(g_theGame->GetGameClock()->GetDeltaSeconds()));
+}
+
+void WindowSubsystem::UpdateWindows(float const deltaSeconds)
+{
+    ++m_predictionFrameIndex;
+    m_frameDeltaSeconds = deltaSeconds;
 
+    CommitWindowRectDeltas();
     UpdateWindowAnimations(deltaSeconds);
+    UpdateRectCoalesceRates(deltaSeconds);
 
+    // 超出預算的視窗在這裡變成虛擬視窗，重新變得重要的在移動前先建立回來
+    EnforceWindowBudget();
 
-    for (auto& [windowId, windowData] : m_windowList)
+    for (size_t denseIndex = 0; denseIndex < m_windows.size(); ++denseIndex)
     {
+        WindowData& windowData = m_windows[denseIndex];
         if (!windowData.m_isActive || !windowData.m_window) continue;
 
-        windowData.m_window->UpdatePosition();
-        windowData.m_window->UpdateDimension();
-
-        if (windowData.m_window->m_shouldUpdateDimension)
+        // 視窗執行緒模式下 HWND 屬於視窗執行緒，只把這一幀的客戶區以 handle 送過去
+        if (m_threadedBackend)
         {
-            HRESULT const hr                             = g_theRenderer->ResizeWindowSwapChain(*windowData.m_window);
-            windowData.m_window->m_shouldUpdateDimension = false;
-
-            if (FAILED(hr))
-            {
-                DebuggerPrintf("Failed to resize window swap chain for WindowID %d: 0x%08X\n", windowId, hr);
-            }
+            PostClientRect(windowData);
+        }
+        else
+        {
+            windowData.m_window->UpdatePosition();
+            windowData.m_window->UpdateDimension();
         }
+
+        UpdateSwapChainSize(m_denseWindowIDs[denseIndex], windowData);
     }
+
+    // 視窗這一幀的位置與尺寸已經確定，拍下快照給 gameplay 讀取
+    CaptureWindowGeometry();
 }
 
 void WindowSubsystem::Render()
 {
-    g_theRenderer->ReadStagingTextureToPixelData();
+    // Gameplay has finished requesting window state for this frame, push only what changed.
+    CommitWindowStates();
 
-    for (auto& [windowId, windowData] : m_windowList)
+    // 比較子視窗實際的位置與實體的位置，量測套用延遲與預測誤差（只在預測開啟時向作業系統查詢）
+    if (m_config.m_isMotionPredictionEnabled)
     {
-        if (!windowData.m_isActive || !windowData.m_window) continue;
+        SampleMotionPrediction();
+    }
 
-        if (windowData.m_window->m_shouldUpdatePosition)
-        {
-            g_theRenderer->RenderViewportToWindow(*windowData.m_window);
-            // g_theRenderer->RenderViewportToWindowDX11(*windowData.m_window);     // TODO: bug fix
-        }
+    // 隱藏、在螢幕外或被上層子視窗完全蓋住的視窗不需要 present
+    UpdateWindowVisibility();
+
+    // 沒有任何子視窗顯示在螢幕上時，整個畫面讀回都可以省掉；模擬後端的視窗沒有 SwapChain 可以 present
+    if (!m_backend->IsNative() || m_visibilityStats.m_frameFullyVisibleCount + m_visibilityStats.m_framePartiallyVisibleCount == 0)
+    {
+        ++m_readbackStats.m_skippedReadbackCount;
     }
+    else
+    {
+        g_theRenderer->ReadStagingTextureToPixelData();
+        ++m_readbackStats.m_readbackCount;
+    }
+
+    // 移動過或內容變了的視窗優先 present，其餘的輪流以較低的頻率更新
+    PresentWindows();
 }
 
 void WindowSubsystem::EndFrame()
@@ -78,6 +257,7 @@ void WindowSubsystem::EndFrame()
 void WindowSubsystem::ShutDown()
 {
     DestroyAllWindows();
+    ClearWindowPool();
 }
 
 WindowID WindowSubsystem::CreateChildWindow(EntityID const owner,
@@ -87,54 +267,70 @@ WindowID WindowSubsystem::CreateChildWindow(EntityID const owner,
                                             int const      width,
                                             int const      height)
 {
-    // 創建作業系統視窗
-    HWND hwnd = CreateOSWindow(windowTitle, x, y, width, height);
+    // 優先從視窗池取出同尺寸的隱藏視窗，沒有才建立新的作業系統視窗
+    sPooledWindow pooledWindow;
+    bool const    isFromPool = AcquirePooledWindow(width, height, pooledWindow);
 
-    if (!hwnd)
+    if (!isFromPool && !CreatePooledWindow(windowTitle, x, y, width, height, pooledWindow))
     {
         DebuggerPrintf("CreateWindowInternal: Failed to create OS window.\n");
         return 0;
     }
 
-    // 生成新的視窗ID
-    WindowID newId = m_nextWindowID++;
-
-    // 創建視窗配置
-    sWindowConfig config;
-    config.m_windowType  = eWindowType::WINDOWED;
-    config.m_aspectRatio = static_cast<float>(width) / static_cast<float>(height);
-    config.m_windowTitle = windowTitle;
-
-    // 創建 Window 物件
-    std::unique_ptr<Window> newWindow = std::make_unique<Window>(config);
+    NativeWindowHandle const nativeHandle = pooledWindow.m_nativeHandle;
 
-    // 設定 HWND 和 Display Context
-    newWindow->SetWindowHandle(hwnd);
-    newWindow->SetDisplayContext(GetDC(hwnd));
+    // 重複使用的視窗要移到新的位置
+    if (isFromPool)
+    {
+        if (pooledWindow.m_window)
+        {
+            pooledWindow.m_window->SetWindowPosition(Vec2(x, y));
+            pooledWindow.m_window->m_shouldUpdatePosition = true;
+        }
+        else
+        {
+            m_backend->SetClientPosition(nativeHandle, nullptr, Vec2(x, y));
+        }
+    }
 
-    // 設定視窗位置和大小追蹤
-    newWindow->SetWindowDimensions(Vec2(width, height));
-    newWindow->SetWindowPosition(Vec2(x, y));
-    newWindow->m_shouldUpdatePosition = true;
+    // 生成新的視窗ID
+    WindowID const newId = AllocateWindowSlot();
+    if (newId == 0)
+    {
+        DebuggerPrintf("CreateWindowInternal: Out of window slots.\n");
+        m_backend->DestroyNativeWindow(nativeHandle, pooledWindow.m_window.get());
+        return 0;
+    }
 
     // 創建 WindowData 並添加到容器
-    std::unordered_set const ownerSet = {owner};
-    WindowData               windowData;
-    windowData.m_window = std::move(newWindow);
-    windowData.m_owners = ownerSet;
-    windowData.m_name   = windowTitle;
-    m_windowList.emplace(newId, std::move(windowData));
+    WindowData windowData;
+    windowData.m_window         = std::move(pooledWindow.m_window);
+    windowData.m_nativeHandle   = nativeHandle;
+    windowData.m_owners.Add(owner);
+    windowData.m_name           = windowTitle;
+    windowData.m_poolBucketSize = IntVec2(width, height);
+    windowData.m_swapChainSize  = IntVec2(width, height);
+
+    // 視窗目前是隱藏的，標題可能還是上一個使用者的（位置由 Window 換算，先標記為未知）
+    windowData.m_desiredState.m_clientDimensions = Vec2(width, height);
+    windowData.m_desiredState.m_title            = windowTitle;
+    windowData.m_desiredState.m_isVisible        = true;
+    windowData.m_appliedState                    = windowData.m_desiredState;
+    windowData.m_appliedState.m_title            = pooledWindow.m_title;
+    windowData.m_appliedState.m_isVisible        = false;
+    windowData.m_appliedFields                   = GetFieldBit(eWindowStateField::VISIBILITY) | GetFieldBit(eWindowStateField::DIMENSIONS) | GetFieldBit(eWindowStateField::TITLE);
+    m_windowSlots[GetSlotIndex(newId)].m_denseIndex = static_cast<uint32_t>(m_windows.size());
+    m_windows.push_back(std::move(windowData));
+    m_denseWindowIDs.push_back(newId);
 
     // 建立actor到視窗的映射
     m_actorToWindow[owner] = newId;
 
-    // 創建 SwapChain
-    if (g_theRenderer)
-    {
-        g_theRenderer->CreateWindowSwapChain(*m_windowList[newId].m_window);
-    }
+    RequestWindowTitle(newId, windowTitle);
+    ShowWindowByWindowID(newId);
 
-    ShowWindow(hwnd, SW_SHOW);
+    // 這一幀稍後建立的實體也要能讀到視窗幾何，不必等到下一次 Update
+    CaptureWindowGeometry(m_windows.back());
 
     DebuggerPrintf("CreateWindowInternal: Created window %d '%s' for actor %llu.\n", newId, windowTitle.c_str(), static_cast<unsigned long long>(owner));
     return newId;
@@ -143,8 +339,8 @@ WindowID WindowSubsystem::CreateChildWindow(EntityID const owner,
 bool WindowSubsystem::AddEntityToWindow(WindowID windowID, EntityID entityID)
 {
     // 檢查視窗是否存在
-    auto windowIt = m_windowList.find(windowID);
-    if (windowIt == m_windowList.end())
+    WindowData* windowData = GetWindowData(windowID);
+    if (windowData == nullptr)
     {
         DebuggerPrintf("AddActorToWindow: Window %d not found.\n", windowID);
         return false;
@@ -168,7 +364,7 @@ bool WindowSubsystem::AddEntityToWindow(WindowID windowID, EntityID entityID)
     }
 
     // 添加映射關係
-    windowIt->second.m_owners.insert(entityID);
+    windowData->m_owners.Add(entityID);
     m_actorToWindow[entityID] = windowID;
 
     DebuggerPrintf("AddActorToWindow: Added Actor %d to Window %d.\n", entityID, windowID);
@@ -178,28 +374,24 @@ bool WindowSubsystem::AddEntityToWindow(WindowID windowID, EntityID entityID)
 bool WindowSubsystem::RemoveEntityFromWindow(WindowID windowID, EntityID entityID)
 {
     // 檢查視窗是否存在
-    auto windowIt = m_windowList.find(windowID);
-    if (windowIt == m_windowList.end())
+    WindowData* windowData = GetWindowData(windowID);
+    if (windowData == nullptr)
     {
         DebuggerPrintf("RemoveActorFromWindow: Window %d not found.\n", windowID);
         return false;
     }
 
-    // 檢查actor是否在該視窗中
-    auto& owners  = windowIt->second.m_owners;
-    auto  actorIt = owners.find(entityID);
-    if (actorIt == owners.end())
+    // 檢查actor是否在該視窗中，並移除映射關係
+    if (!windowData->m_owners.Remove(entityID))
     {
         DebuggerPrintf("RemoveActorFromWindow: Actor %d not in window %d.\n", entityID, windowID);
         return false;
     }
 
-    // 移除映射關係
-    owners.erase(actorIt);
     m_actorToWindow.erase(entityID);
 
     // 如果視窗沒有任何owner了，自動銷毀視窗
-    if (owners.empty())
+    if (windowData->m_owners.IsEmpty())
     {
         DebuggerPrintf("RemoveActorFromWindow: Window %d now empty, destroying.\n", windowID);
         DestroyWindow(windowID);
@@ -214,437 +406,1651 @@ bool WindowSubsystem::RemoveEntityFromWindow(WindowID windowID, EntityID entityI
 
 void WindowSubsystem::DestroyWindow(WindowID windowID)
 {
-    auto windowIt = m_windowList.find(windowID);
-    if (windowIt == m_windowList.end())
+    WindowData* windowData = GetWindowData(windowID);
+    if (windowData == nullptr)
     {
         DebuggerPrintf("DestroyWindow: Window %d not found.\n", windowID);
         return;
     }
 
     // 移除所有相關的actor映射
-    for (EntityID actorId : windowIt->second.m_owners)
+    for (EntityID const actorId : windowData->m_owners)
     {
         m_actorToWindow.erase(actorId);
     }
 
-    // 關閉視窗
-    if (windowIt->second.m_window)
-    {
-        windowIt->second.m_window->Shutdown();
-    }
+    // 通知所有快取此視窗的綁定
+    InvalidateWindowBindings(*windowData);
 
-    // 移除視窗資料
-    m_windowList.erase(windowIt);
+    // 能回收就放回視窗池，否則關閉視窗（虛擬視窗早已沒有作業系統視窗）
+    if (!windowData->m_isVirtual) ReleaseWindowToPool(*windowData);
 
-    DebuggerPrintf("DestroyWindow: Window %d destroyed.\n", windowID);
+    // 移除視窗資料（最後一個視窗搬進空位）
+    m_windowTweens.CancelAll(windowID);
+    m_windowSpatialIndex.Remove(windowID);
+    FreeWindowSlot(windowID);
 }
 
 void WindowSubsystem::DestroyAllWindows()
 {
-    for (auto& [windowId, windowData] : m_windowList)
+    // 逐一釋放 slot，讓舊的 WindowID 全部失效
+    while (!m_denseWindowIDs.empty())
     {
-        if (windowData.m_window)
-        {
-            windowData.m_window->Shutdown();
-        }
+        WindowData& windowData = m_windows.back();
+        InvalidateWindowBindings(windowData);
+        if (!windowData.m_isVirtual) m_backend->DestroyNativeWindow(windowData.m_nativeHandle, windowData.m_window.get());
+        FreeWindowSlot(m_denseWindowIDs.back());
     }
 
-    m_windowList.clear();
     m_actorToWindow.clear();
+    m_windowTweens.Clear();
+    m_windowSpatialIndex.Clear();
 
     DebuggerPrintf("DestroyAllWindows: All windows destroyed.\n");
 }
 
-void WindowSubsystem::ShowWindowByWindowID(WindowID windowID)
-{
-    Window* window = GetWindow(windowID);
-    if (window) ShowWindow((HWND)window->GetWindowHandle(), SW_SHOW);
-}
-
-void WindowSubsystem::HideWindowByWindowID(WindowID windowID)
-{
-    Window* window = GetWindow(windowID);
-    if (window) ShowWindow((HWND)window->GetWindowHandle(), SW_HIDE);
-}
-
 //----------------------------------------------------------------------------------------------------
-// 查詢功能
+// 綁定：實體快取視窗ID與 Window*，視窗被銷毀時由這裡清除
 //----------------------------------------------------------------------------------------------------
 
-Window* WindowSubsystem::GetWindow(WindowID windowID)
+bool WindowSubsystem::BindWindow(WindowID const windowID, sWindowBinding& binding)
 {
-    auto it = m_windowList.find(windowID);
-    return (it != m_windowList.end() && it->second.m_window) ? it->second.m_window.get() : nullptr;
-}
+    UnbindWindow(binding);
 
-WindowData* WindowSubsystem::GetWindowData(WindowID const windowID)
-{
-    auto it = m_windowList.find(windowID);
-    return (it != m_windowList.end()) ? &it->second : nullptr;
-}
+    WindowData* windowData = GetWindowData(windowID);
+    if (windowData == nullptr)
+    {
+        DebuggerPrintf("BindWindow: Window %d not found.\n", windowID);
+        return false;
+    }
 
-WindowID WindowSubsystem::FindWindowIDByEntityID(EntityID const entityID)
-{
-    auto it = m_actorToWindow.find(entityID);
-    return (it != m_actorToWindow.end()) ? it->second : 0;
+    binding.m_windowID = windowID;
+    binding.m_window   = windowData->m_window.get();
+    windowData->m_bindings.push_back(&binding);
+    return true;
 }
 
-std::vector<EntityID> WindowSubsystem::GetWindowOwners(WindowID const windowID)
+void WindowSubsystem::UnbindWindow(sWindowBinding& binding)
 {
-    std::vector<EntityID> result;
-    auto                  it = m_windowList.find(windowID);
-    if (it != m_windowList.end())
+    WindowData* windowData = GetWindowData(binding.m_windowID);
+    if (windowData != nullptr)
     {
-        for (EntityID actorId : it->second.m_owners)
+        std::vector<sWindowBinding*>& bindings = windowData->m_bindings;
+        auto const                    it       = std::find(bindings.begin(), bindings.end(), &binding);
+        if (it != bindings.end())
         {
-            result.push_back(actorId);
+            *it = bindings.back();
+            bindings.pop_back();
         }
     }
-    return result;
+
+    binding.Invalidate();
 }
 
-std::vector<WindowID> WindowSubsystem::GetActorWindows(EntityID const entityID)
+void WindowSubsystem::InvalidateWindowBindings(WindowData& windowData)
 {
-    std::vector<WindowID> result;
-    auto                  it = m_actorToWindow.find(entityID);
-    if (it != m_actorToWindow.end())
+    for (sWindowBinding* binding : windowData.m_bindings)
     {
-        result.push_back(it->second);
+        binding->Invalidate();
     }
-    return result;
+
+    windowData.m_bindings.clear();
 }
 
-std::vector<WindowID> WindowSubsystem::GetAllWindowIDs()
+void WindowSubsystem::RefreshWindowBindings(WindowData& windowData)
 {
-    std::vector<WindowID> result;
-    for (const auto& [windowId, windowData] : m_windowList)
+    for (sWindowBinding* binding : windowData.m_bindings)
     {
-        result.push_back(windowId);
+        binding->m_window = windowData.m_window.get();
     }
-    return result;
 }
 
-bool WindowSubsystem::IsActorInWindow(WindowID const windowID, EntityID const entityID)
+void WindowSubsystem::ShowWindowByWindowID(WindowID windowID)
 {
-    auto it = m_windowList.find(windowID);
-    if (it != m_windowList.end())
+    WindowData* windowData = GetWindowData(windowID);
+    if (windowData == nullptr) return;
+
+    // 虛擬視窗只記下需求，重新建立時才真正顯示
+    if (windowData->m_isVirtual)
     {
-        return it->second.m_owners.find(entityID) != it->second.m_owners.end();
+        windowData->m_desiredState.m_isVisible = true;
+        return;
     }
-    return false;
+
+    m_backend->SetVisible(windowData->m_nativeHandle, true);
+    windowData->m_appliedState.m_isVisible = true;
+    windowData->m_desiredState.m_isVisible = true;
+    windowData->m_appliedFields |= GetFieldBit(eWindowStateField::VISIBILITY);
 }
 
-bool WindowSubsystem::WindowExists(WindowID const windowID)
+void WindowSubsystem::HideWindowByWindowID(WindowID windowID)
 {
-    return m_windowList.find(windowID) != m_windowList.end();
+    WindowData* windowData = GetWindowData(windowID);
+    if (windowData == nullptr) return;
+
+    if (windowData->m_isVirtual)
+    {
+        windowData->m_desiredState.m_isVisible = false;
+        return;
+    }
+
+    m_backend->SetVisible(windowData->m_nativeHandle, false);
+    windowData->m_appliedState.m_isVisible = false;
+    windowData->m_desiredState.m_isVisible = false;
+    windowData->m_appliedFields |= GetFieldBit(eWindowStateField::VISIBILITY);
 }
 
 //----------------------------------------------------------------------------------------------------
-// 視窗操作
+// 狀態協調：遊戲邏輯每幀提出需求，只有與已套用狀態不同時才呼叫作業系統
 //----------------------------------------------------------------------------------------------------
 
-void WindowSubsystem::UpdateWindowPosition(WindowID const windowID)
+void WindowSubsystem::RequestWindowVisibility(WindowID const windowID, bool const isVisible)
 {
-    auto it = m_windowList.find(windowID);
-    if (it != m_windowList.end() && it->second.m_window)
-    {
-        it->second.m_window->UpdatePosition();
-    }
-    else
-    {
-        DebuggerPrintf("UpdateWindowPosition: Window %d not found.\n", windowID);
-    }
+    WindowData* windowData = GetWindowData(windowID);
+    if (windowData == nullptr) return;
+
+    windowData->m_desiredState.m_isVisible = isVisible;
+    windowData->m_dirtyFields |= GetFieldBit(eWindowStateField::VISIBILITY);
+    ++m_reconcileStats.m_frameRequested[(int)eWindowStateField::VISIBILITY];
+    ++m_reconcileStats.m_totalRequested[(int)eWindowStateField::VISIBILITY];
 }
 
-void WindowSubsystem::UpdateWindowPosition(WindowID const windowID,
-                                           Vec2 const&    newPosition)
+void WindowSubsystem::RequestClientPosition(WindowID const windowID, Vec2 const& clientPosition)
 {
-    auto it = m_windowList.find(windowID);
-    if (it != m_windowList.end() && it->second.m_window)
-    {
-        it->second.m_window->SetWindowPosition(it->second.m_window->GetWindowPosition() + newPosition);
-        Vec2 totalPosition = it->second.m_window->GetWindowPosition() + newPosition;
-        // it->second.window->UpdatePosition(newPosition);
-        // it->second.window->m_shouldUpdatePosition = true;
-        DebuggerPrintf("(NewPosition: %f, %f)\n", newPosition.x, newPosition.y);
-        DebuggerPrintf("(it->second.window->GetWindowPosition(): %f, %f)\n", it->second.m_window->GetWindowPosition().x, it->second.m_window->GetWindowPosition().y);
-    }
-    else
-    {
-        DebuggerPrintf("UpdateWindowPosition: Window %d not found.\n", windowID);
-    }
+    WindowData* windowData = GetWindowData(windowID);
+    if (windowData == nullptr) return;
+
+    windowData->m_desiredState.m_clientPosition = QuantizeToPixel(clientPosition);
+    windowData->m_dirtyFields |= GetFieldBit(eWindowStateField::POSITION);
+    ++m_reconcileStats.m_frameRequested[(int)eWindowStateField::POSITION];
+    ++m_reconcileStats.m_totalRequested[(int)eWindowStateField::POSITION];
 }
 
-void WindowSubsystem::UpdateWindowDimension(WindowID windowID)
+// The window is led by velocity times the measured apply latency, so it lands where the entity will be when
+// the OS gets round to moving it. The lead is eased rather than snapped, so when the entity turns or stops the
+// window drifts back onto it instead of jumping.
+void WindowSubsystem::RequestClientPosition(WindowID const windowID, Vec2 const& clientPosition, Vec2 const& velocity)
 {
-    auto it = m_windowList.find(windowID);
-    if (it != m_windowList.end() && it->second.m_window)
+    if (!m_config.m_isMotionPredictionEnabled)
     {
-        it->second.m_window->UpdateDimension();
+        RequestClientPosition(windowID, clientPosition);
+        return;
     }
-    else
+
+    WindowData* windowData = GetWindowData(windowID);
+    if (windowData == nullptr) return;
+
+    windowData->m_unpredictedClientPosition = clientPosition;
+    windowData->m_hasMotionRequest          = true;
+
+    float const leadSeconds  = std::min(m_predictionStats.m_applyLatencyFrames * m_frameDeltaSeconds, m_config.m_maxPredictionLeadSeconds);
+    Vec2 const  targetOffset = velocity * leadSeconds;
+    float const smoothing    = m_config.m_predictionSmoothingSeconds;
+    float const blend        = smoothing > 0.f ? std::min(m_frameDeltaSeconds / smoothing, 1.f) : 1.f;
+    windowData->m_predictionOffset += (targetOffset - windowData->m_predictionOffset) * blend;
+
+    RequestClientPosition(windowID, clientPosition + windowData->m_predictionOffset);
+}
+
+void WindowSubsystem::RequestClientDimensions(WindowID const windowID, Vec2 const& clientDimensions)
+{
+    WindowData* windowData = GetWindowData(windowID);
+    if (windowData == nullptr) return;
+
+    windowData->m_desiredState.m_clientDimensions = QuantizeToPixel(clientDimensions);
+    windowData->m_dirtyFields |= GetFieldBit(eWindowStateField::DIMENSIONS);
+    ++m_reconcileStats.m_frameRequested[(int)eWindowStateField::DIMENSIONS];
+    ++m_reconcileStats.m_totalRequested[(int)eWindowStateField::DIMENSIONS];
+}
+
+void WindowSubsystem::RequestWindowTitle(WindowID const windowID, String const& title)
+{
+    WindowData* windowData = GetWindowData(windowID);
+    if (windowData == nullptr) return;
+
+    windowData->m_desiredState.m_title = title;
+    windowData->m_dirtyFields |= GetFieldBit(eWindowStateField::TITLE);
+    ++m_reconcileStats.m_frameRequested[(int)eWindowStateField::TITLE];
+    ++m_reconcileStats.m_totalRequested[(int)eWindowStateField::TITLE];
+}
+
+void WindowSubsystem::CommitWindowStates()
+{
+    for (WindowData& windowData : m_windows)
     {
-        DebuggerPrintf("UpdateWindowDimension: Window %d not found.\n", windowID);
+        if (windowData.m_dirtyFields == 0 || !windowData.m_nativeHandle) continue;
+
+        CommitSingleWindowState(windowData);
     }
 }
 
-void WindowSubsystem::SetWindowActive(WindowID windowID, bool active)
+sWindowReconcileStats const& WindowSubsystem::GetReconcileStats() const
+{
+    return m_reconcileStats;
+}
+
+void WindowSubsystem::CommitSingleWindowState(WindowData& windowData)
 {
-    auto it = m_windowList.find(windowID);
-    if (it != m_windowList.end())
+    Window*                  window       = windowData.m_window.get();
+    NativeWindowHandle const nativeHandle = windowData.m_nativeHandle;
+    sWindowState const&      desired      = windowData.m_desiredState;
+    sWindowState&            applied      = windowData.m_appliedState;
+
+    // A field is committed when it was requested and either differs from, or was never confirmed by, the OS.
+    auto needsCommit = [&windowData](eWindowStateField const field, bool const isSameAsApplied) {
+        uint8_t const fieldBit = GetFieldBit(field);
+        if ((windowData.m_dirtyFields & fieldBit) == 0) return false;
+        return (windowData.m_appliedFields & fieldBit) == 0 || !isSameAsApplied;
+    };
+
+    auto markIssued = [this, &windowData](eWindowStateField const field) {
+        windowData.m_appliedFields |= GetFieldBit(field);
+        ++m_reconcileStats.m_frameIssued[(int)field];
+        ++m_reconcileStats.m_totalIssued[(int)field];
+    };
+
+    // Hide before moving and show after moving, so the window never flashes at its old rect.
+    if (!desired.m_isVisible && needsCommit(eWindowStateField::VISIBILITY, applied.m_isVisible == desired.m_isVisible))
     {
-        it->second.m_isActive = active;
+        m_backend->SetVisible(nativeHandle, false);
+        applied.m_isVisible = false;
+        markIssued(eWindowStateField::VISIBILITY);
+    }
 
-        DebuggerPrintf("SetWindowActive: Window %d set to %s.\n", windowID, active ? "active" : "inactive");
+    if (needsCommit(eWindowStateField::DIMENSIONS, applied.m_clientDimensions == desired.m_clientDimensions))
+    {
+        m_backend->SetClientDimensions(nativeHandle, window, desired.m_clientDimensions);
+        applied.m_clientDimensions = desired.m_clientDimensions;
+        markIssued(eWindowStateField::DIMENSIONS);
     }
-    else
+
+    if (needsCommit(eWindowStateField::POSITION, applied.m_clientPosition == desired.m_clientPosition))
     {
-        DebuggerPrintf("SetWindowActive: Window %d not found.\n", windowID);
+        m_backend->SetClientPosition(nativeHandle, window, desired.m_clientPosition);
+        applied.m_clientPosition = desired.m_clientPosition;
+        markIssued(eWindowStateField::POSITION);
+        if (windowData.m_hasMotionRequest) RecordIssuedMove(windowData, desired.m_clientPosition);
     }
-}
 
-void WindowSubsystem::SetWindowName(WindowID windowId, const std::string& name)
-{
-    auto it = m_windowList.find(windowId);
-    if (it != m_windowList.end())
+    if (needsCommit(eWindowStateField::TITLE, applied.m_title == desired.m_title))
     {
-        it->second.m_name = name;
-        DebuggerPrintf("SetWindowName: Window %d renamed to '%s'.\n", windowId, name.c_str());
+        m_backend->SetTitle(nativeHandle, desired.m_title);
+        applied.m_title = desired.m_title;
+        markIssued(eWindowStateField::TITLE);
     }
-    else
+
+    if (desired.m_isVisible && needsCommit(eWindowStateField::VISIBILITY, applied.m_isVisible == desired.m_isVisible))
     {
-        DebuggerPrintf("SetWindowName: Window %d not found.\n", windowId);
+        m_backend->SetVisible(nativeHandle, true);
+        applied.m_isVisible = true;
+        markIssued(eWindowStateField::VISIBILITY);
     }
+
+    windowData.m_dirtyFields = 0;
 }
 
-std::string WindowSubsystem::GetWindowName(WindowID windowId)
+void WindowSubsystem::InvalidateAppliedState(WindowData& windowData, eWindowStateField const field)
 {
-    auto it = m_windowList.find(windowId);
-    return (it != m_windowList.end()) ? it->second.m_name : "";
+    windowData.m_appliedFields &= static_cast<uint8_t>(~GetFieldBit(field));
 }
 
-size_t WindowSubsystem::GetActiveWindowCount() const
+//----------------------------------------------------------------------------------------------------
+// 查詢功能
+//----------------------------------------------------------------------------------------------------
+
+Window* WindowSubsystem::GetWindow(WindowID windowID)
 {
-    size_t count = 0;
-    for (const auto& [windowId, windowData] : m_windowList)
-    {
-        if (windowData.m_isActive)
-        {
-            count++;
-        }
-    }
-    return count;
+    WindowData const* windowData = GetWindowData(windowID);
+    return windowData != nullptr ? windowData->m_window.get() : nullptr;
 }
 
-//----------------------------------------------------------------------------------------------------
-size_t WindowSubsystem::GetWindowCount() const
+WindowData* WindowSubsystem::GetWindowData(WindowID const windowID)
 {
-    return m_windowList.size();
+    uint32_t const denseIndex = FindDenseIndex(windowID);
+    return denseIndex != INVALID_WINDOW_DENSE_INDEX ? &m_windows[denseIndex] : nullptr;
 }
 
+WindowData const* WindowSubsystem::GetWindowData(WindowID const windowID) const
+{
+    uint32_t const denseIndex = FindDenseIndex(windowID);
+    return denseIndex != INVALID_WINDOW_DENSE_INDEX ? &m_windows[denseIndex] : nullptr;
+}
 
-void WindowSubsystem::RemoveEntityFromMappings(EntityID entityID)
+WindowID WindowSubsystem::FindWindowIDByEntityID(EntityID const entityID)
 {
     auto it = m_actorToWindow.find(entityID);
-    if (it != m_actorToWindow.end())
-    {
-        WindowID windowId = it->second;
-        RemoveEntityFromWindow(windowId, entityID);
-    }
+    return (it != m_actorToWindow.end()) ? it->second : 0;
 }
 
-HWND WindowSubsystem::CreateOSWindow(String const& title,
-                                     int const     x,
-                                     int const     y,
-                                     int const     width,
-                                     int const     height)
-{
-    // 轉換名稱為寬字符
-    std::wstring wTitle;
-    wTitle.resize(title.size());
-    MultiByteToWideChar(CP_UTF8, 0, title.c_str(), static_cast<int>(title.size()), wTitle.data(), static_cast<int>(wTitle.size()));
-
-    // 註冊視窗類別（只需要註冊一次）
-    static bool classRegistered = false;
-    if (!classRegistered)
-    {
-        WNDCLASS wc      = {};
-        wc.lpfnWndProc   = (WNDPROC)GetWindowLongPtr((HWND)Window::s_mainWindow->GetWindowHandle(), GWLP_WNDPROC);
-        wc.hInstance     = GetModuleHandle(nullptr);
-        wc.lpszClassName = L"ChildWindow";
-        wc.hbrBackground = (HBRUSH)(COLOR_WINDOW + 1);
-        wc.hCursor       = LoadCursor(nullptr, IDC_ARROW);
-        wc.hIcon         = (HICON)LoadImage(
-            NULL,
-            m_config.m_iconFilePath,
-            IMAGE_ICON,
-            32, 32,
-            LR_LOADFROMFILE
-        );
-        RegisterClass(&wc);
-        classRegistered = true;
-    }
-
-    // 調整視窗大小，確保客戶區域是指定的 width 和 height
-    RECT rect = {0, 0, width, height};
-    AdjustWindowRectEx(&rect, WS_OVERLAPPEDWINDOW, FALSE, 0);
-
-    int adjustedWidth  = rect.right - rect.left;
-    int adjustedHeight = rect.bottom - rect.top;
-
-    HWND hwnd = CreateWindowEx(
-        0,
-        L"ChildWindow",
-        wTitle.c_str(),
-        WS_OVERLAPPED | WS_CAPTION | WS_SYSMENU,
-        x, y, adjustedWidth, adjustedHeight,
-        nullptr,
-        nullptr,
-        GetModuleHandle(nullptr),
-        nullptr
-    );
-
-    return hwnd;
+sConstSpan<EntityID> WindowSubsystem::GetWindowOwners(WindowID const windowID) const
+{
+    WindowData const* windowData = GetWindowData(windowID);
+    return windowData != nullptr ? windowData->m_owners.AsSpan() : sConstSpan<EntityID>{};
+}
+
+sConstSpan<WindowID> WindowSubsystem::GetActorWindows(EntityID const entityID) const
+{
+    // 一個actor只能在一個視窗，直接指向映射表裡的值
+    auto const it = m_actorToWindow.find(entityID);
+    return it != m_actorToWindow.end() ? sConstSpan<WindowID>{&it->second, 1} : sConstSpan<WindowID>{};
+}
+
+sConstSpan<WindowID> WindowSubsystem::GetAllWindowIDs() const
+{
+    return {m_denseWindowIDs.data(), m_denseWindowIDs.size()};
+}
+
+bool WindowSubsystem::IsActorInWindow(WindowID const windowID, EntityID const entityID) const
+{
+    WindowData const* windowData = GetWindowData(windowID);
+    return windowData != nullptr && windowData->m_owners.Contains(entityID);
+}
+
+bool WindowSubsystem::WindowExists(WindowID const windowID) const
+{
+    return FindDenseIndex(windowID) != INVALID_WINDOW_DENSE_INDEX;
+}
+
+sWindowGeometry const* WindowSubsystem::GetWindowGeometry(WindowID const windowID) const
+{
+    WindowData const* windowData = GetWindowData(windowID);
+    return windowData != nullptr ? &windowData->m_geometry : nullptr;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Slot map：WindowID 經由 slot 找到 m_windows 的索引，世代不符代表 ID 已過期
+//----------------------------------------------------------------------------------------------------
+
+WindowID WindowSubsystem::AllocateWindowSlot()
+{
+    uint32_t slotIndex;
+
+    if (!m_freeWindowSlots.empty())
+    {
+        slotIndex = m_freeWindowSlots.back();
+        m_freeWindowSlots.pop_back();
+    }
+    else
+    {
+        if (m_windowSlots.size() > WINDOW_ID_INDEX_MASK) return 0;
+
+        slotIndex = static_cast<uint32_t>(m_windowSlots.size());
+        m_windowSlots.emplace_back();
+    }
+
+    return (m_windowSlots[slotIndex].m_generation << WINDOW_ID_INDEX_BITS) | slotIndex;
+}
+
+void WindowSubsystem::FreeWindowSlot(WindowID const windowID)
+{
+    uint32_t const denseIndex = FindDenseIndex(windowID);
+    if (denseIndex == INVALID_WINDOW_DENSE_INDEX) return;
+
+    // Swap-remove: the last window moves into the hole and its slot is pointed at the new index.
+    uint32_t const lastIndex = static_cast<uint32_t>(m_windows.size() - 1);
+    if (denseIndex != lastIndex)
+    {
+        m_windows[denseIndex]        = std::move(m_windows[lastIndex]);
+        m_denseWindowIDs[denseIndex] = m_denseWindowIDs[lastIndex];
+        m_windowSlots[GetSlotIndex(m_denseWindowIDs[denseIndex])].m_denseIndex = denseIndex;
+    }
+    m_windows.pop_back();
+    m_denseWindowIDs.pop_back();
+
+    sWindowSlot& slot = m_windowSlots[GetSlotIndex(windowID)];
+    slot.m_denseIndex = INVALID_WINDOW_DENSE_INDEX;
+    slot.m_generation = (slot.m_generation + 1) & WINDOW_ID_GENERATION_MASK;
+    if (slot.m_generation == 0) slot.m_generation = 1;
+    m_freeWindowSlots.push_back(GetSlotIndex(windowID));
+}
+
+uint32_t WindowSubsystem::FindDenseIndex(WindowID const windowID) const
+{
+    uint32_t const slotIndex = GetSlotIndex(windowID);
+    if (windowID == 0 || slotIndex >= m_windowSlots.size()) return INVALID_WINDOW_DENSE_INDEX;
+
+    sWindowSlot const& slot = m_windowSlots[slotIndex];
+    return slot.m_generation == GetGeneration(windowID) ? slot.m_denseIndex : INVALID_WINDOW_DENSE_INDEX;
+}
+
+// Native windows answer from the engine Window, the mock backend keeps its own rects. With a window
+// thread the Window only holds what was requested, so geometry comes from the thread's snapshot instead.
+// A virtual window is wherever gameplay last asked it to be.
+AABB2 WindowSubsystem::QueryClientRect(WindowData const& windowData)
+{
+    if (windowData.m_isVirtual)
+    {
+        sWindowState const& desired = windowData.m_desiredState;
+        return AABB2(desired.m_clientPosition, desired.m_clientPosition + desired.m_clientDimensions);
+    }
+
+    if (windowData.m_window && !m_threadedBackend)
+    {
+        Vec2 const clientPosition = windowData.m_window->GetClientPosition();
+        return AABB2(clientPosition, clientPosition + windowData.m_window->GetClientDimensions());
+    }
+
+    return m_backend->GetClientRect(windowData.m_nativeHandle, nullptr);
+}
+
+void WindowSubsystem::CaptureWindowGeometry()
+{
+    for (size_t denseIndex = 0; denseIndex < m_windows.size(); ++denseIndex)
+    {
+        WindowData&    windowData = m_windows[denseIndex];
+        WindowID const windowID   = m_denseWindowIDs[denseIndex];
+
+        CaptureWindowGeometry(windowData);
+
+        // 只有位置或尺寸真的變了才會讓格子重建
+        if (windowData.m_geometry.m_isVisible)
+        {
+            m_windowSpatialIndex.SetRect(windowID, windowData.m_geometry.m_clientRect);
+        }
+        else
+        {
+            m_windowSpatialIndex.Remove(windowID);
+        }
+    }
+
+    m_windowSpatialIndex.Rebuild();
+}
+
+void WindowSubsystem::CaptureWindowGeometry(WindowData& windowData)
+{
+    sWindowGeometry&      geometry         = windowData.m_geometry;
+    sWindowGeometry const previousGeometry = geometry;
+
+    geometry.m_isVisible  = windowData.m_isActive && (windowData.m_isVirtual ? windowData.m_desiredState : windowData.m_appliedState).m_isVisible;
+    geometry.m_clientRect = QueryClientRect(windowData);
+
+    // The mock backend and the window thread only know client rects
+    if (windowData.m_window && !m_threadedBackend)
+    {
+        Vec2 const windowPosition = windowData.m_window->GetWindowPosition();
+        geometry.m_windowRect     = AABB2(windowPosition, windowPosition + windowData.m_window->GetWindowDimensions());
+    }
+    else
+    {
+        geometry.m_windowRect = geometry.m_clientRect;
+    }
+
+    bool const isChanged = geometry.m_isVisible != previousGeometry.m_isVisible ||
+                           geometry.m_clientRect.m_mins != previousGeometry.m_clientRect.m_mins ||
+                           geometry.m_clientRect.m_maxs != previousGeometry.m_clientRect.m_maxs ||
+                           geometry.m_windowRect.m_mins != previousGeometry.m_windowRect.m_mins ||
+                           geometry.m_windowRect.m_maxs != previousGeometry.m_windowRect.m_maxs;
+    if (isChanged)
+    {
+        ++geometry.m_revision;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// 視窗操作
+//----------------------------------------------------------------------------------------------------
+
+void WindowSubsystem::UpdateWindowPosition(WindowID const windowID)
+{
+    Window* window = GetWindow(windowID);
+    if (window != nullptr)
+    {
+        // With a window thread the next UpdateWindows posts the move
+        if (!m_threadedBackend) window->UpdatePosition();
+    }
+    else
+    {
+        DebuggerPrintf("UpdateWindowPosition: Window %d not found.\n", windowID);
+    }
+}
+
+void WindowSubsystem::UpdateWindowPosition(WindowID const windowID,
+                                           Vec2 const&    newPosition)
+{
+    Window* window = GetWindow(windowID);
+    if (window != nullptr)
+    {
+        window->SetWindowPosition(window->GetWindowPosition() + newPosition);
+        // window->UpdatePosition(newPosition);
+        // window->m_shouldUpdatePosition = true;
+    }
+    else
+    {
+        DebuggerPrintf("UpdateWindowPosition: Window %d not found.\n", windowID);
+    }
+}
+
+void WindowSubsystem::UpdateWindowDimension(WindowID windowID)
+{
+    Window* window = GetWindow(windowID);
+    if (window != nullptr)
+    {
+        if (!m_threadedBackend) window->UpdateDimension();
+    }
+    else
+    {
+        DebuggerPrintf("UpdateWindowDimension: Window %d not found.\n", windowID);
+    }
+}
+
+void WindowSubsystem::SetWindowActive(WindowID windowID, bool active)
+{
+    WindowData* windowData = GetWindowData(windowID);
+    if (windowData != nullptr)
+    {
+        windowData->m_isActive = active;
+
+        DebuggerPrintf("SetWindowActive: Window %d set to %s.\n", windowID, active ? "active" : "inactive");
+    }
+    else
+    {
+        DebuggerPrintf("SetWindowActive: Window %d not found.\n", windowID);
+    }
+}
+
+void WindowSubsystem::SetWindowName(WindowID windowId, const std::string& name)
+{
+    WindowData* windowData = GetWindowData(windowId);
+    if (windowData != nullptr)
+    {
+        windowData->m_name = name;
+        RequestWindowTitle(windowId, name);
+        DebuggerPrintf("SetWindowName: Window %d renamed to '%s'.\n", windowId, name.c_str());
+    }
+    else
+    {
+        DebuggerPrintf("SetWindowName: Window %d not found.\n", windowId);
+    }
+}
+
+std::string WindowSubsystem::GetWindowName(WindowID windowId)
+{
+    WindowData const* windowData = GetWindowData(windowId);
+    return windowData != nullptr ? windowData->m_name : "";
+}
+
+size_t WindowSubsystem::GetActiveWindowCount() const
+{
+    size_t count = 0;
+    for (WindowData const& windowData : m_windows)
+    {
+        if (windowData.m_isActive)
+        {
+            count++;
+        }
+    }
+    return count;
+}
+
+//----------------------------------------------------------------------------------------------------
+size_t WindowSubsystem::GetWindowCount() const
+{
+    return m_windows.size();
+}
+
+//----------------------------------------------------------------------------------------------------
+IWindowBackend* WindowSubsystem::GetBackend() const
+{
+    return m_backend;
+}
+
+bool WindowSubsystem::IsUsingWindowThread() const
+{
+    return m_threadedBackend != nullptr;
+}
+
+void WindowSubsystem::FlushWindowThread()
+{
+    if (m_threadedBackend) m_threadedBackend->Flush();
+}
+
+sWindowThreadStats WindowSubsystem::GetWindowThreadStats() const
+{
+    return m_threadedBackend ? m_threadedBackend->GetThreadStats() : sWindowThreadStats();
+}
+
+// Stands in for Window::UpdatePosition/UpdateDimension, which call the OS from the game thread. Only the
+// parts of the Window's requested client rect that changed since the last post are queued, by handle.
+void WindowSubsystem::PostClientRect(WindowData& windowData)
+{
+    Window const* window           = windowData.m_window.get();
+    Vec2 const    clientPosition   = QuantizeToPixel(window->GetClientPosition());
+    Vec2 const    clientDimensions = QuantizeToPixel(window->GetClientDimensions());
+    bool const    isFirstPost      = windowData.m_postedClientDimensions == Vec2::ZERO;
+
+    if (clientDimensions != windowData.m_postedClientDimensions)
+    {
+        m_backend->SetClientDimensions(windowData.m_nativeHandle, nullptr, clientDimensions);
+        windowData.m_postedClientDimensions = clientDimensions;
+    }
+
+    if (isFirstPost || clientPosition != windowData.m_postedClientPosition)
+    {
+        m_backend->SetClientPosition(windowData.m_nativeHandle, nullptr, clientPosition);
+        windowData.m_postedClientPosition = clientPosition;
+    }
+}
+
+//----------------------------------------------------------------------------------------------------
+// 視窗池：預先建立隱藏的子視窗，生成波次時不必等待 CreateWindowEx / GetDC / SwapChain
+//----------------------------------------------------------------------------------------------------
+
+void WindowSubsystem::WarmUpWindowPool(int const width, int const height, int const count)
+{
+    std::vector<sPooledWindow>& bucket = m_windowPool[MakePoolBucketKey(width, height)];
+
+    size_t const targetCount = std::min(static_cast<size_t>(count), m_config.m_maxPooledWindowsPerBucket);
+
+    while (bucket.size() < targetCount)
+    {
+        sPooledWindow pooledWindow;
+        if (!CreatePooledWindow("Pooled Window", 0, 0, width, height, pooledWindow)) break;
+
+        bucket.push_back(std::move(pooledWindow));
+        ++m_windowPoolStats.m_warmUpCount;
+        ++m_windowPoolStats.m_pooledCount;
+    }
+
+    DebuggerPrintf("WarmUpWindowPool: %d x %d bucket holds %d windows.\n", width, height, static_cast<int>(bucket.size()));
+}
+
+void WindowSubsystem::ClearWindowPool()
+{
+    for (auto& [bucketKey, bucket] : m_windowPool)
+    {
+        for (sPooledWindow& pooledWindow : bucket)
+        {
+            m_backend->DestroyNativeWindow(pooledWindow.m_nativeHandle, pooledWindow.m_window.get());
+        }
+    }
+
+    m_windowPool.clear();
+    m_windowPoolStats.m_pooledCount = 0;
+}
+
+sWindowPoolStats const& WindowSubsystem::GetWindowPoolStats() const
+{
+    return m_windowPoolStats;
+}
+
+bool WindowSubsystem::CreatePooledWindow(String const&  title,
+                                         int const      x,
+                                         int const      y,
+                                         int const      width,
+                                         int const      height,
+                                         sPooledWindow& out_pooledWindow)
+{
+    // 創建作業系統視窗（建立時為隱藏狀態）
+    NativeWindowHandle const nativeHandle = m_backend->CreateNativeWindow(title, x, y, width, height);
+    if (!nativeHandle) return false;
+
+    out_pooledWindow.m_nativeHandle = nativeHandle;
+    out_pooledWindow.m_title        = title;
+
+    // 只有原生後端才需要 Window 物件（Display Context 與 SwapChain 都掛在上面）
+    if (!m_backend->IsNative()) return true;
+
+    // 創建視窗配置
+    sWindowConfig config;
+    config.m_windowType  = eWindowType::WINDOWED;
+    config.m_aspectRatio = static_cast<float>(width) / static_cast<float>(height);
+    config.m_windowTitle = title;
+
+    // 創建 Window 物件
+    std::unique_ptr<Window> newWindow = std::make_unique<Window>(config);
+
+    // 設定 HWND 和 Display Context
+    newWindow->SetWindowHandle(nativeHandle);
+    newWindow->SetDisplayContext(m_backend->AcquireDisplayContext(nativeHandle));
+
+    // 設定視窗位置和大小追蹤
+    newWindow->SetWindowDimensions(Vec2(width, height));
+    newWindow->SetWindowPosition(Vec2(x, y));
+    newWindow->m_shouldUpdatePosition = true;
+
+    // 創建 SwapChain
+    if (g_theRenderer)
+    {
+        g_theRenderer->CreateWindowSwapChain(*newWindow);
+    }
+
+    out_pooledWindow.m_window = std::move(newWindow);
+    return true;
+}
+
+bool WindowSubsystem::AcquirePooledWindow(int const width, int const height, sPooledWindow& out_pooledWindow)
+{
+    auto const bucketIt = m_windowPool.find(MakePoolBucketKey(width, height));
+    if (bucketIt == m_windowPool.end() || bucketIt->second.empty())
+    {
+        ++m_windowPoolStats.m_missCount;
+        return false;
+    }
+
+    out_pooledWindow = std::move(bucketIt->second.back());
+    bucketIt->second.pop_back();
+
+    ++m_windowPoolStats.m_hitCount;
+    --m_windowPoolStats.m_pooledCount;
+    return true;
+}
+
+bool WindowSubsystem::ReleaseWindowToPool(WindowData& windowData)
+{
+    IntVec2 const bucketSize = windowData.m_poolBucketSize;
+
+    // 尺寸被改過（例如動畫）的視窗不再屬於原本的尺寸分組，直接關閉
+    bool const isSizeKnown     = (windowData.m_appliedFields & GetFieldBit(eWindowStateField::DIMENSIONS)) != 0;
+    bool const isSizeUnchanged = isSizeKnown && windowData.m_appliedState.m_clientDimensions == Vec2(bucketSize.x, bucketSize.y);
+
+    std::vector<sPooledWindow>& bucket = m_windowPool[MakePoolBucketKey(bucketSize.x, bucketSize.y)];
+
+    if (!isSizeUnchanged || bucket.size() >= m_config.m_maxPooledWindowsPerBucket)
+    {
+        m_backend->DestroyNativeWindow(windowData.m_nativeHandle, windowData.m_window.get());
+        ++m_windowPoolStats.m_discardCount;
+        return false;
+    }
+
+    if (windowData.m_appliedState.m_isVisible || (windowData.m_appliedFields & GetFieldBit(eWindowStateField::VISIBILITY)) == 0)
+    {
+        m_backend->SetVisible(windowData.m_nativeHandle, false);
+    }
+
+    sPooledWindow pooledWindow;
+    pooledWindow.m_window       = std::move(windowData.m_window);
+    pooledWindow.m_nativeHandle = windowData.m_nativeHandle;
+    pooledWindow.m_title        = windowData.m_appliedState.m_title;
+    bucket.push_back(std::move(pooledWindow));
+
+    ++m_windowPoolStats.m_returnCount;
+    ++m_windowPoolStats.m_pooledCount;
+    return true;
+}
+
+
+void WindowSubsystem::RemoveEntityFromMappings(EntityID entityID)
+{
+    auto it = m_actorToWindow.find(entityID);
+    if (it != m_actorToWindow.end())
+    {
+        WindowID windowId = it->second;
+        RemoveEntityFromWindow(windowId, entityID);
+    }
 }
 
 void WindowSubsystem::SetupTransparentMainWindow()
 {
-    if (!Window::s_mainWindow) return;
+    if (!Window::s_mainWindow) return;
+
+    HWND mainHwnd = static_cast<HWND>(Window::s_mainWindow->GetWindowHandle());
+
+    // 設置全螢幕透明主視窗
+    SetWindowLong(mainHwnd, GWL_EXSTYLE,
+                  GetWindowLong(mainHwnd, GWL_EXSTYLE) | WS_EX_LAYERED | WS_EX_TRANSPARENT);
+
+    // 完全透明，滑鼠穿透
+    SetLayeredWindowAttributes(mainHwnd, 0, 0, LWA_ALPHA);
+
+    // 設置為全螢幕覆蓋
+    int screenWidth  = GetSystemMetrics(SM_CXSCREEN);
+    int screenHeight = GetSystemMetrics(SM_CYSCREEN);
+
+    SetWindowPos(mainHwnd, HWND_TOPMOST, 0, 0, screenWidth, screenHeight,
+                 SWP_SHOWWINDOW);
+}
+
+String WindowSubsystem::GenerateDefaultWindowName(sConstSpan<EntityID> const& owners) const
+{
+    if (owners.empty()) return Stringf("Empty Window");
+
+    if (owners.size() == 1)
+    {
+        return "Actor " + std::to_string(owners[0]) + " Window";
+    }
+
+    std::string name = "Shared Window (";
+    for (size_t i = 0; i < owners.size(); ++i)
+    {
+        name += std::to_string(owners[i]);
+        if (i < owners.size() - 1) name += ", ";
+    }
+    name += ")";
+
+    return name;
+}
+
+void WindowSubsystem::AnimateWindowDimensions(WindowID const id, Vec2 const& targetDimensions, float const duration, eEasingType const easingType)
+{
+    MaterializeWindowOnDemand(id);
+
+    Window* window = GetWindow(id);
+    if (window == nullptr) return;
+    if (targetDimensions == window->GetWindowDimensions()) return;
+
+    m_windowTweens.Start(id, (uint8_t)eWindowTweenChannel::DIMENSIONS, window->GetWindowDimensions(), targetDimensions, duration, easingType);
+}
+
+void WindowSubsystem::AnimateWindowPosition(WindowID const id, Vec2 const& targetPosition, float const duration, eEasingType const easingType)
+{
+    MaterializeWindowOnDemand(id);
+
+    Window* window = GetWindow(id);
+    if (window == nullptr) return;
+    if (targetPosition == window->GetWindowPosition()) return;
+
+    m_windowTweens.Start(id, (uint8_t)eWindowTweenChannel::POSITION, window->GetWindowPosition(), targetPosition, duration, easingType);
+}
+
+void WindowSubsystem::AnimateWindowPositionAndDimensions(WindowID const id, Vec2 const& targetPosition, Vec2 const& targetDimensions, float const duration, eEasingType const easingType)
+{
+    MaterializeWindowOnDemand(id);
+
+    Window* window = GetWindow(id);
+    if (window == nullptr) return;
+
+    m_windowTweens.Start(id, (uint8_t)eWindowTweenChannel::POSITION, window->GetWindowPosition(), targetPosition, duration, easingType);
+    m_windowTweens.Start(id, (uint8_t)eWindowTweenChannel::DIMENSIONS, window->GetWindowDimensions(), targetDimensions, duration, easingType);
+}
+
+void WindowSubsystem::UpdateWindowAnimations(float const deltaSeconds)
+{
+    m_windowTweens.Update(deltaSeconds, [this](uint64_t const targetKey, uint8_t const channel, Vec2 const& value) {
+        ApplyWindowTweenValue(static_cast<WindowID>(targetKey), static_cast<eWindowTweenChannel>(channel), value);
+    });
+}
+
+void WindowSubsystem::ApplyWindowTweenValue(WindowID const windowID, eWindowTweenChannel const channel, Vec2 const& value)
+{
+    WindowData* windowData = GetWindowData(windowID);
+    if (windowData == nullptr || !windowData->m_window) return;
+
+    Window*    window     = windowData->m_window.get();
+    Vec2 const pixelValue = QuantizeToPixel(value);
+
+    // 動畫直接改動 Window，協調器記錄的位置與尺寸不再可信
+    // 停在同一個像素上的動畫幀不必移動視窗，尺寸更不必重建 SwapChain
+    if (channel == eWindowTweenChannel::POSITION)
+    {
+        if (pixelValue == QuantizeToPixel(window->GetWindowPosition())) return;
+
+        InvalidateAppliedState(*windowData, eWindowStateField::POSITION);
+        window->SetWindowPosition(pixelValue);
+    }
+    else
+    {
+        if (pixelValue == QuantizeToPixel(window->GetWindowDimensions()))
+        {
+            ++m_rectCoalesceStats.m_resizeSkippedCount;
+            return;
+        }
+
+        InvalidateAppliedState(*windowData, eWindowStateField::DIMENSIONS);
+        window->SetWindowDimensions(pixelValue);
+        ++m_rectCoalesceStats.m_resizeAppliedCount;
+    }
+}
+
+bool WindowSubsystem::IsWindowAnimating(WindowID const id) const
+{
+    return m_windowTweens.IsAnyActive(id);
+}
+
+sTweenStats const& WindowSubsystem::GetWindowTweenStats() const
+{
+    return m_windowTweens.GetStats();
+}
+
+//----------------------------------------------------------------------------------------------------
+// 合併同一幀內的相對請求：多個子彈同時撞邊只會產生一個目標，正在跑的動畫直接改目標而不重新開始
+//----------------------------------------------------------------------------------------------------
+
+void WindowSubsystem::RequestWindowRectDelta(WindowID const id, Vec2 const& positionDelta, Vec2 const& dimensionsDelta, float const duration, eEasingType const easingType)
+{
+    // 動畫直接驅動 Window，虛擬視窗要先建立回來
+    MaterializeWindowOnDemand(id);
+
+    WindowData* windowData = GetWindowData(id);
+    if (windowData == nullptr || !windowData->m_window) return;
+
+    windowData->m_pendingPositionDelta += positionDelta;
+    windowData->m_pendingDimensionsDelta += dimensionsDelta;
+    windowData->m_pendingDurationSeconds = windowData->m_hasPendingRectDelta ? std::max(windowData->m_pendingDurationSeconds, duration) : duration;
+    windowData->m_pendingEasingType      = easingType;
+    windowData->m_hasPendingRectDelta    = true;
+
+    ++m_rectCoalesceStats.m_requestCount;
+}
+
+sWindowRectCoalesceStats const& WindowSubsystem::GetRectCoalesceStats() const
+{
+    return m_rectCoalesceStats;
+}
+
+void WindowSubsystem::CommitWindowRectDeltas()
+{
+    for (size_t denseIndex = 0; denseIndex < m_windows.size(); ++denseIndex)
+    {
+        WindowData& windowData = m_windows[denseIndex];
+        if (!windowData.m_hasPendingRectDelta) continue;
 
-    HWND mainHwnd = static_cast<HWND>(Window::s_mainWindow->GetWindowHandle());
+        WindowID const windowID = m_denseWindowIDs[denseIndex];
+        Window*        window   = windowData.m_window.get();
 
-    // 設置全螢幕透明主視窗
-    SetWindowLong(mainHwnd, GWL_EXSTYLE,
-                  GetWindowLong(mainHwnd, GWL_EXSTYLE) | WS_EX_LAYERED | WS_EX_TRANSPARENT);
+        // Deltas stack on the target already being animated toward, not on wherever the window is mid-flight.
+        auto commitChannel = [&](eWindowTweenChannel const channel, Vec2 const& delta, Vec2 const& currentValue) {
+            if (delta == Vec2::ZERO) return false;
 
-    // 完全透明，滑鼠穿透
-    SetLayeredWindowAttributes(mainHwnd, 0, 0, LWA_ALPHA);
+            uint8_t const channelIndex = static_cast<uint8_t>(channel);
+            Vec2          targetValue;
 
-    // 設置為全螢幕覆蓋
-    int screenWidth  = GetSystemMetrics(SM_CXSCREEN);
-    int screenHeight = GetSystemMetrics(SM_CYSCREEN);
+            if (m_windowTweens.GetTargetValue(windowID, channelIndex, targetValue))
+            {
+                m_windowTweens.Retarget(windowID, channelIndex, targetValue + delta, windowData.m_pendingDurationSeconds);
+                return false;
+            }
 
-    SetWindowPos(mainHwnd, HWND_TOPMOST, 0, 0, screenWidth, screenHeight,
-                 SWP_SHOWWINDOW);
+            m_windowTweens.Start(windowID, channelIndex, currentValue, currentValue + delta, windowData.m_pendingDurationSeconds, windowData.m_pendingEasingType);
+            return true;
+        };
+
+        bool const isPositionStarted   = commitChannel(eWindowTweenChannel::POSITION, windowData.m_pendingPositionDelta, window->GetWindowPosition());
+        bool const isDimensionsStarted = commitChannel(eWindowTweenChannel::DIMENSIONS, windowData.m_pendingDimensionsDelta, window->GetWindowDimensions());
+        bool const isEmptyRequest      = windowData.m_pendingPositionDelta == Vec2::ZERO && windowData.m_pendingDimensionsDelta == Vec2::ZERO;
+
+        if (isPositionStarted || isDimensionsStarted) ++m_rectCoalesceStats.m_tweenStartCount;
+        else if (!isEmptyRequest) ++m_rectCoalesceStats.m_tweenRetargetCount;
+
+        windowData.m_pendingPositionDelta   = Vec2::ZERO;
+        windowData.m_pendingDimensionsDelta = Vec2::ZERO;
+        windowData.m_hasPendingRectDelta    = false;
+    }
 }
 
-String WindowSubsystem::GenerateDefaultWindowName(std::vector<EntityID> const& owners) const
+void WindowSubsystem::UpdateRectCoalesceRates(float const deltaSeconds)
 {
-    if (owners.empty()) return Stringf("Empty Window");
+    m_rectCoalesceSecondTimer += deltaSeconds;
+    if (m_rectCoalesceSecondTimer < 1.f) return;
 
-    if (owners.size() == 1)
+    sWindowRectCoalesceStats&       stats = m_rectCoalesceStats;
+    sWindowRectCoalesceStats const& last  = m_rectCoalesceStatsAtLastSecond;
+
+    stats.m_requestsPerSecond       = stats.m_requestCount - last.m_requestCount;
+    stats.m_tweenStartsPerSecond    = stats.m_tweenStartCount - last.m_tweenStartCount;
+    stats.m_tweenRetargetsPerSecond = stats.m_tweenRetargetCount - last.m_tweenRetargetCount;
+    stats.m_resizesAppliedPerSecond = stats.m_resizeAppliedCount - last.m_resizeAppliedCount;
+    stats.m_resizesSkippedPerSecond = stats.m_resizeSkippedCount - last.m_resizeSkippedCount;
+
+    m_rectCoalesceStatsAtLastSecond = stats;
+    m_rectCoalesceSecondTimer       = 0.f;
+}
+
+//----------------------------------------------------------------------------------------------------
+// SwapChain 重建節流：尺寸動畫進行中先沿用舊的 SwapChain，動畫結束或尺寸差太多才真正重建
+//----------------------------------------------------------------------------------------------------
+
+uint32_t WindowSubsystem::GetSwapChainResizeCount(WindowID const windowID) const
+{
+    WindowData const* windowData = GetWindowData(windowID);
+    return windowData != nullptr ? windowData->m_swapChainResizeCount : 0;
+}
+
+sSwapChainResizeStats const& WindowSubsystem::GetSwapChainResizeStats() const
+{
+    return m_swapChainResizeStats;
+}
+
+// The renderer always presents the whole back buffer, so a swap chain that lags the client size is
+// stretched into the window. That is accepted while a DIMENSIONS animation is changing the size every
+// frame anyway: the reallocation waits for the animation to end, or for the client size to drift more
+// than m_swapChainResizeSlack pixels from the buffer, which bounds both the stretch and the reallocation
+// rate of long or continually retargeted animations. Changes without an animation resize immediately.
+void WindowSubsystem::UpdateSwapChainSize(WindowID const windowID, WindowData& windowData)
+{
+    Window*    window    = windowData.m_window.get();
+    bool const isChanged = window->m_shouldUpdateDimension;
+
+    if (isChanged)
     {
-        return "Actor " + std::to_string(owners[0]) + " Window";
+        window->m_shouldUpdateDimension        = false;
+        windowData.m_hasPendingSwapChainResize = true;
     }
 
-    std::string name = "Shared Window (";
-    for (size_t i = 0; i < owners.size(); ++i)
+    if (!windowData.m_hasPendingSwapChainResize) return;
+
+    Vec2 const    clientDimensions = QuantizeToPixel(window->GetClientDimensions());
+    IntVec2 const clientSize       = IntVec2(static_cast<int>(clientDimensions.x), static_cast<int>(clientDimensions.y));
+    if (clientSize == windowData.m_swapChainSize)
     {
-        name += std::to_string(owners[i]);
-        if (i < owners.size() - 1) name += ", ";
+        windowData.m_hasPendingSwapChainResize = false;
+        return;
     }
-    name += ")";
 
-    return name;
+    int const  drift       = std::max(std::abs(clientSize.x - windowData.m_swapChainSize.x), std::abs(clientSize.y - windowData.m_swapChainSize.y));
+    bool const isAnimating = m_windowTweens.IsActive(windowID, static_cast<uint8_t>(eWindowTweenChannel::DIMENSIONS));
+    bool const isDrifted   = drift > m_config.m_swapChainResizeSlack;
+
+    if (isAnimating && !isDrifted)
+    {
+        if (isChanged)
+        {
+            ++windowData.m_swapChainDeferredResizeCount;
+            ++m_swapChainResizeStats.m_deferredResizeCount;
+        }
+        return;
+    }
+
+    HRESULT const hr = g_theRenderer->ResizeWindowSwapChain(*window);
+    if (FAILED(hr))
+    {
+        DebuggerPrintf("Failed to resize window swap chain for WindowID %d: 0x%08X\n", windowID, hr);
+    }
+
+    windowData.m_swapChainSize             = clientSize;
+    windowData.m_hasPendingSwapChainResize = false;
+    ++windowData.m_swapChainResizeCount;
+    ++m_swapChainResizeStats.m_resizeCount;
+    if (isAnimating) ++m_swapChainResizeStats.m_driftResizeCount;
 }
 
-void WindowSubsystem::AnimateWindowDimensions(WindowID id, Vec2 const& targetDimensions, float duration)
+//----------------------------------------------------------------------------------------------------
+// 讀回：只有在至少一個子視窗顯示在螢幕上時才從畫面讀回
+//----------------------------------------------------------------------------------------------------
+
+sWindowReadbackStats const& WindowSubsystem::GetReadbackStats() const
 {
-    auto windowIt = m_windowList.find(id);
-    if (windowIt == m_windowList.end()) return;
+    return m_readbackStats;
+}
 
-    Window* window = windowIt->second.m_window.get();
-    if (targetDimensions == window->GetWindowDimensions()) return;
+//----------------------------------------------------------------------------------------------------
+// 可見性：依客戶區與 z-order 把子視窗分成完全遮蔽、部分可見、完全可見
+//----------------------------------------------------------------------------------------------------
+
+eWindowVisibility WindowSubsystem::GetWindowVisibility(WindowID const windowID) const
+{
+    WindowData const* windowData = GetWindowData(windowID);
+    return windowData != nullptr ? windowData->m_visibility : eWindowVisibility::FULLY_OCCLUDED;
+}
 
-    WindowAnimationData& animData     = m_windowAnimations[id];
-    animData.m_startWindowDimensions  = window->GetWindowDimensions();
-    animData.m_targetWindowDimensions = targetDimensions;
-    animData.m_animationDuration      = duration;
-    animData.m_animationTimer         = 0.0f;
-    animData.m_isAnimatingSize        = true;
+sWindowVisibilityStats const& WindowSubsystem::GetVisibilityStats() const
+{
+    return m_visibilityStats;
 }
 
-void WindowSubsystem::AnimateWindowPosition(WindowID id, Vec2 const& targetPosition, float duration)
+// Only child windows count as occluders. The transparent main window spans the whole screen and other
+// applications are not tracked, so a window is covered when the child windows above it hide every one
+// of its on-screen pixels.
+void WindowSubsystem::UpdateWindowVisibility()
 {
-    auto windowIt = m_windowList.find(id);
-    if (windowIt == m_windowList.end()) return;
+    m_visibilityStats.m_frameFullyVisibleCount     = 0;
+    m_visibilityStats.m_framePartiallyVisibleCount = 0;
+    m_visibilityStats.m_frameOccludedCount         = 0;
 
-    Window* window = windowIt->second.m_window.get();
-    if (targetPosition == window->GetWindowPosition()) return;
+    m_zOrderHandles.clear();
+    m_zSortedDenseIndices.clear();
+
+    Vec2 const       screenDimensions = Window::s_mainWindow ? QuantizeToPixel(Window::s_mainWindow->GetScreenDimensions()) : Vec2::ZERO;
+    sPixelRect const screenRect       = {0, 0, static_cast<int>(screenDimensions.x), static_cast<int>(screenDimensions.y)};
+
+    // Hidden and off-screen windows are settled without asking the OS for their z-order
+    for (uint32_t denseIndex = 0; denseIndex < static_cast<uint32_t>(m_windows.size()); ++denseIndex)
+    {
+        WindowData& windowData = m_windows[denseIndex];
+
+        if (windowData.m_isVirtual)
+        {
+            ClassifyOcclusion(windowData, eWindowOcclusionCause::VIRTUALIZED);
+            continue;
+        }
+
+        if (!windowData.m_isActive || !windowData.m_appliedState.m_isVisible)
+        {
+            ClassifyOcclusion(windowData, eWindowOcclusionCause::HIDDEN);
+            continue;
+        }
+
+        windowData.m_clientPixelRect = GetClientPixelRect(QueryClientRect(windowData), screenDimensions.y);
+
+        if (!windowData.m_clientPixelRect.Overlaps(screenRect))
+        {
+            ClassifyOcclusion(windowData, eWindowOcclusionCause::OFF_SCREEN);
+            continue;
+        }
+
+        m_zSortedDenseIndices.push_back(denseIndex);
+        m_zOrderHandles.push_back(windowData.m_nativeHandle);
+    }
+
+    if (m_zSortedDenseIndices.empty()) return;
+
+    m_backend->QueryZOrder(m_zOrderHandles, m_zOrders);
+    for (size_t candidateIndex = 0; candidateIndex < m_zSortedDenseIndices.size(); ++candidateIndex)
+    {
+        m_windows[m_zSortedDenseIndices[candidateIndex]].m_zOrder = m_zOrders[candidateIndex];
+    }
+
+    std::sort(m_zSortedDenseIndices.begin(), m_zSortedDenseIndices.end(), [this](uint32_t const lhs, uint32_t const rhs) {
+        uint32_t const lhsZOrder = m_windows[lhs].m_zOrder;
+        uint32_t const rhsZOrder = m_windows[rhs].m_zOrder;
+        return lhsZOrder != rhsZOrder ? lhsZOrder < rhsZOrder : lhs < rhs;
+    });
+
+    // Top to bottom: whatever the windows above cover of this window's on-screen rect is hidden
+    for (size_t sortedIndex = 0; sortedIndex < m_zSortedDenseIndices.size(); ++sortedIndex)
+    {
+        WindowData&      windowData   = m_windows[m_zSortedDenseIndices[sortedIndex]];
+        sPixelRect const onScreenRect = windowData.m_clientPixelRect.GetIntersection(screenRect);
+
+        m_coveringRects.clear();
+        for (size_t aboveIndex = 0; aboveIndex < sortedIndex; ++aboveIndex)
+        {
+            sPixelRect const& aboveRect = m_windows[m_zSortedDenseIndices[aboveIndex]].m_clientPixelRect;
+            if (aboveRect.Overlaps(onScreenRect)) m_coveringRects.push_back(aboveRect);
+        }
+
+        int64_t coveredArea = 0;
+        if (!m_coveringRects.empty())
+        {
+            PixelRegion::ComputeUnion(m_coveringRects, onScreenRect, m_coveredRegion);
+            coveredArea = PixelRegion::GetArea(m_coveredRegion);
+        }
+
+        if (coveredArea >= onScreenRect.GetArea())
+        {
+            ClassifyOcclusion(windowData, eWindowOcclusionCause::COVERED);
+            continue;
+        }
+
+        windowData.m_occlusionCause = eWindowOcclusionCause::NONE;
+
+        if (coveredArea == 0 && onScreenRect.GetArea() == windowData.m_clientPixelRect.GetArea())
+        {
+            windowData.m_visibility = eWindowVisibility::FULLY_VISIBLE;
+            ++m_visibilityStats.m_frameFullyVisibleCount;
+        }
+        else
+        {
+            windowData.m_visibility = eWindowVisibility::PARTIALLY_VISIBLE;
+            ++m_visibilityStats.m_framePartiallyVisibleCount;
+        }
+    }
+}
+
+void WindowSubsystem::ClassifyOcclusion(WindowData& windowData, eWindowOcclusionCause const cause)
+{
+    windowData.m_visibility     = eWindowVisibility::FULLY_OCCLUDED;
+    windowData.m_occlusionCause = cause;
+    ++m_visibilityStats.m_frameOccludedCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// 空間查詢：每個 Update 更新一次的子視窗客戶區格子索引
+//----------------------------------------------------------------------------------------------------
+
+void WindowSubsystem::QueryWindowsAtPoint(Vec2 const& point, std::vector<WindowID>& out_windowIDs) const
+{
+    m_windowSpatialIndex.QueryPoint(point, out_windowIDs);
+}
+
+void WindowSubsystem::QueryWindowsInDisc(Vec2 const& center, float const radius, std::vector<WindowID>& out_windowIDs) const
+{
+    m_windowSpatialIndex.QueryDisc(center, radius, out_windowIDs);
+}
+
+void WindowSubsystem::QueryWindowsInRect(AABB2 const& rect, std::vector<WindowID>& out_windowIDs) const
+{
+    m_windowSpatialIndex.QueryRect(rect, out_windowIDs);
+}
+
+WindowSpatialIndex const& WindowSubsystem::GetWindowSpatialIndex() const
+{
+    return m_windowSpatialIndex;
+}
+
+//----------------------------------------------------------------------------------------------------
+// 視窗預算：超出上限時，最久沒出現在螢幕上、離焦點最遠的視窗釋放作業系統視窗與 SwapChain
+//----------------------------------------------------------------------------------------------------
 
-    WindowAnimationData& animData   = m_windowAnimations[id];
-    animData.m_startWindowPosition  = window->GetWindowPosition();
-    animData.m_targetWindowPosition = targetPosition;
-    animData.m_animationDuration    = duration;
-    animData.m_animationTimer       = 0.0f;
-    animData.m_isAnimatingPosition  = true;
+void WindowSubsystem::SetWindowPinned(WindowID const windowID, bool const isPinned)
+{
+    WindowData* windowData = GetWindowData(windowID);
+    if (windowData == nullptr) return;
+
+    windowData->m_isPinned = isPinned;
+    if (isPinned) MaterializeWindowOnDemand(windowID);
+}
+
+void WindowSubsystem::SetWindowBudgetFocus(Vec2 const& focusPosition)
+{
+    m_budgetFocus = focusPosition;
+}
+
+bool WindowSubsystem::IsWindowVirtual(WindowID const windowID) const
+{
+    WindowData const* windowData = GetWindowData(windowID);
+    return windowData != nullptr && windowData->m_isVirtual;
 }
 
-void WindowSubsystem::UpdateWindowAnimations(float deltaSeconds)
+sWindowBudgetStats const& WindowSubsystem::GetWindowBudgetStats() const
 {
-    for (auto& [windowId, animData] : m_windowAnimations)
+    return m_budgetStats;
+}
+
+// Ranks every window by (pinned or animating, last frame it was shown on screen, distance to the focus) and
+// keeps the first m_maxLiveWindows live. Relevant virtual windows inside the budget are rematerialised,
+// live windows outside it are virtualised. Pinned and animating windows stay live even past the budget.
+// Ranking reads the geometry captured at the end of the previous frame, never the backend.
+void WindowSubsystem::EnforceWindowBudget()
+{
+    ++m_budgetFrameIndex;
+
+    uint32_t const maxLiveWindows   = m_config.m_maxLiveWindows;
+    float const    hysteresisSq     = m_config.m_windowBudgetHysteresis * m_config.m_windowBudgetHysteresis;
+    Vec2 const     screenDimensions = Window::s_mainWindow ? Window::s_mainWindow->GetScreenDimensions() : Vec2::ZERO;
+    bool const     hasScreen        = screenDimensions != Vec2::ZERO;
+
+    m_budgetCandidates.clear();
+    uint32_t protectedCount = 0;
+
+    for (uint32_t denseIndex = 0; denseIndex < static_cast<uint32_t>(m_windows.size()); ++denseIndex)
+    {
+        WindowData&  windowData = m_windows[denseIndex];
+        AABB2 const& clientRect = windowData.m_geometry.m_clientRect;
+
+        bool const isShown    = windowData.m_isActive && windowData.m_desiredState.m_isVisible;
+        bool const isOnScreen = !hasScreen || (clientRect.m_maxs.x > 0.f && clientRect.m_mins.x < screenDimensions.x &&
+                                               clientRect.m_maxs.y > 0.f && clientRect.m_mins.y < screenDimensions.y);
+        if (isShown && isOnScreen) windowData.m_lastRelevantFrame = m_budgetFrameIndex;
+
+        sWindowBudgetCandidate candidate;
+        candidate.m_denseIndex        = denseIndex;
+        candidate.m_isProtected       = windowData.m_isPinned || m_windowTweens.IsAnyActive(m_denseWindowIDs[denseIndex]);
+        candidate.m_lastRelevantFrame = windowData.m_lastRelevantFrame;
+        candidate.m_rankDistanceSq    = GetDistanceSquared2D(clientRect.GetCenter(), m_budgetFocus);
+        if (!windowData.m_isVirtual) candidate.m_rankDistanceSq *= hysteresisSq;
+
+        if (candidate.m_isProtected) ++protectedCount;
+        m_budgetCandidates.push_back(candidate);
+    }
+
+    // 只需要知道誰在前 maxLiveWindows 名，名次內外的順序都不重要
+    if (maxLiveWindows > 0 && m_budgetCandidates.size() > maxLiveWindows)
+    {
+        std::nth_element(m_budgetCandidates.begin(), m_budgetCandidates.begin() + maxLiveWindows, m_budgetCandidates.end(), [](sWindowBudgetCandidate const& lhs, sWindowBudgetCandidate const& rhs) {
+            if (lhs.m_isProtected != rhs.m_isProtected) return lhs.m_isProtected;
+            if (lhs.m_lastRelevantFrame != rhs.m_lastRelevantFrame) return lhs.m_lastRelevantFrame > rhs.m_lastRelevantFrame;
+            if (lhs.m_rankDistanceSq != rhs.m_rankDistanceSq) return lhs.m_rankDistanceSq < rhs.m_rankDistanceSq;
+            return lhs.m_denseIndex < rhs.m_denseIndex;
+        });
+
+        if (protectedCount > maxLiveWindows) ++m_budgetStats.m_overBudgetFrameCount;
+    }
+
+    uint32_t liveCount = 0;
+
+    for (size_t rank = 0; rank < m_budgetCandidates.size(); ++rank)
     {
-        if (animData.IsAnimating())
+        sWindowBudgetCandidate const& candidate  = m_budgetCandidates[rank];
+        WindowData&                   windowData = m_windows[candidate.m_denseIndex];
+        WindowID const                windowID   = m_denseWindowIDs[candidate.m_denseIndex];
+        bool const                    isInBudget = maxLiveWindows == 0 || rank < maxLiveWindows || candidate.m_isProtected;
+        bool const                    isRelevant = candidate.m_lastRelevantFrame == m_budgetFrameIndex;
+
+        // A virtual window that is not on screen gains nothing from coming back, its budget slot stays free
+        if (isInBudget && windowData.m_isVirtual && (isRelevant || candidate.m_isProtected))
+        {
+            MaterializeWindow(windowID, windowData);
+        }
+        else if (!isInBudget && !windowData.m_isVirtual)
         {
-            UpdateSingleWindowAnimation(windowId, animData, deltaSeconds);
+            VirtualizeWindow(windowID, windowData);
         }
+
+        if (!windowData.m_isVirtual) ++liveCount;
+    }
+
+    m_budgetStats.m_maxLiveWindows = maxLiveWindows;
+    m_budgetStats.m_liveCount      = liveCount;
+    m_budgetStats.m_virtualCount   = static_cast<uint32_t>(m_windows.size()) - liveCount;
+    m_budgetStats.m_peakLiveCount  = std::max(m_budgetStats.m_peakLiveCount, liveCount);
+}
+
+void WindowSubsystem::VirtualizeWindow(WindowID const windowID, WindowData& windowData)
+{
+    // 記住視窗目前的位置與尺寸，虛擬期間回報這個矩形，重新建立時也回到這裡（尚未送出的需求優先）
+    AABB2 const clientRect = QueryClientRect(windowData);
+    if ((windowData.m_dirtyFields & GetFieldBit(eWindowStateField::POSITION)) == 0)
+    {
+        windowData.m_desiredState.m_clientPosition = QuantizeToPixel(clientRect.m_mins);
+    }
+    if ((windowData.m_dirtyFields & GetFieldBit(eWindowStateField::DIMENSIONS)) == 0)
+    {
+        windowData.m_desiredState.m_clientDimensions = QuantizeToPixel(clientRect.m_maxs - clientRect.m_mins);
     }
+
+    // 放回視窗池（隱藏）或直接關閉，之後這個視窗沒有 HWND 也沒有 SwapChain
+    ReleaseWindowToPool(windowData);
+    windowData.m_window.reset();
+    windowData.m_nativeHandle = nullptr;
+    windowData.m_isVirtual    = true;
+
+    windowData.m_appliedFields             = 0;
+    windowData.m_appliedState.m_isVisible  = false;
+    windowData.m_hasPendingSwapChainResize = false;
+    windowData.m_zOrder                    = UINT32_MAX;
+    windowData.m_issuedMoveCount           = 0;
+    RefreshWindowBindings(windowData);
+
+    ++m_budgetStats.m_frameEvictionCount;
+    ++m_budgetStats.m_evictionCount;
+}
+
+bool WindowSubsystem::MaterializeWindow(WindowID const windowID, WindowData& windowData)
+{
+    sWindowState const& desired = windowData.m_desiredState;
+    int const           width   = static_cast<int>(desired.m_clientDimensions.x);
+    int const           height  = static_cast<int>(desired.m_clientDimensions.y);
+
+    sPooledWindow pooledWindow;
+    if (!AcquirePooledWindow(width, height, pooledWindow) && !CreatePooledWindow(desired.m_title, 0, 0, width, height, pooledWindow))
+    {
+        DebuggerPrintf("MaterializeWindow: Failed to create OS window for Window %d.\n", windowID);
+        return false;
+    }
+
+    windowData.m_window         = std::move(pooledWindow.m_window);
+    windowData.m_nativeHandle   = pooledWindow.m_nativeHandle;
+    windowData.m_isVirtual      = false;
+    windowData.m_poolBucketSize         = IntVec2(width, height);
+    windowData.m_swapChainSize          = IntVec2(width, height);
+    windowData.m_postedClientDimensions = Vec2::ZERO;
+    RefreshWindowBindings(windowData);
+
+    // 視窗是隱藏的，位置未知。先送出位置、尺寸與標題，顯示留給 Render 的 CommitWindowStates，
+    // 讓視窗在 Update 移到定位之後才出現
+    windowData.m_appliedState.m_title     = pooledWindow.m_title;
+    windowData.m_appliedState.m_isVisible = false;
+    windowData.m_appliedFields            = GetFieldBit(eWindowStateField::VISIBILITY) | GetFieldBit(eWindowStateField::TITLE);
+    windowData.m_dirtyFields              = GetFieldBit(eWindowStateField::POSITION) | GetFieldBit(eWindowStateField::DIMENSIONS) | GetFieldBit(eWindowStateField::TITLE);
+    CommitSingleWindowState(windowData);
+    windowData.m_dirtyFields = GetFieldBit(eWindowStateField::VISIBILITY);
+
+    // 新的 SwapChain 還沒有任何內容，要當成從未 present 過
+    windowData.m_lastPresentFrame = 0;
+
+    ++m_budgetStats.m_frameRematerializeCount;
+    ++m_budgetStats.m_rematerializeCount;
+    return true;
+}
+
+void WindowSubsystem::MaterializeWindowOnDemand(WindowID const windowID)
+{
+    WindowData* windowData = GetWindowData(windowID);
+    if (windowData == nullptr || !windowData->m_isVirtual) return;
+
+    if (MaterializeWindow(windowID, *windowData)) ++m_budgetStats.m_onDemandRematerializeCount;
+}
+
+//----------------------------------------------------------------------------------------------------
+// Present 排程：每幀只在預算內 present，移動或內容改變的視窗優先，其餘輪流更新
+//----------------------------------------------------------------------------------------------------
+
+void WindowSubsystem::MarkWindowContentChanged(WindowID const windowID)
+{
+    WindowData* windowData = GetWindowData(windowID);
+    if (windowData != nullptr) windowData->m_isContentChanged = true;
+}
+
+void WindowSubsystem::MarkWindowContentChangedInDisc(Vec2 const& center, float const radius)
+{
+    m_windowSpatialIndex.QueryDisc(center, radius, m_contentChangedScratch);
+
+    for (WindowID const windowID : m_contentChangedScratch)
+    {
+        MarkWindowContentChanged(windowID);
+    }
+}
+
+sWindowPresentInfo WindowSubsystem::GetWindowPresentInfo(WindowID const windowID) const
+{
+    sWindowPresentInfo presentInfo;
+
+    WindowData const* windowData = GetWindowData(windowID);
+    if (windowData == nullptr || windowData->m_lastPresentFrame == 0) return presentInfo;
+
+    presentInfo.m_refreshRate         = windowData->m_refreshRate;
+    presentInfo.m_framesSincePresent  = m_renderFrameIndex - windowData->m_lastPresentFrame;
+    presentInfo.m_secondsSincePresent = GetPresentClockSeconds() - windowData->m_lastPresentSeconds;
+    presentInfo.m_hasPresented        = true;
+    return presentInfo;
+}
+
+sWindowPresentStats const& WindowSubsystem::GetPresentStats() const
+{
+    return m_presentStats;
 }
 
-void WindowSubsystem::UpdateSingleWindowAnimation(WindowID id, WindowAnimationData& animData, float deltaSeconds)
+// Every visible window gets a priority from its share of the screen, how far it moved since it was last
+// presented, whether content under it changed and how stale it is. Urgent windows (moved, changed or never
+// presented) are always due, the others only every m_idlePresentIntervalFrames. Due windows are presented
+// in priority order until the count or time budget runs out. Whatever misses the budget is staler, and so
+// ranks higher, next frame, which makes the idle refresh a round-robin over the oldest windows.
+void WindowSubsystem::PresentWindows()
 {
-    auto windowIt = m_windowList.find(id);
-    if (windowIt == m_windowList.end()) return;
+    static constexpr float MOVE_WEIGHT            = 1.f;
+    static constexpr float MOVE_SATURATION_PIXELS = 64.f;
+    static constexpr float CONTENT_WEIGHT         = 1.f;
+    static constexpr float STALENESS_WEIGHT       = 0.05f;
+
+    ++m_renderFrameIndex;
+
+    m_presentStats.m_frameCandidateCount = 0;
+    m_presentStats.m_frameUrgentCount    = 0;
+    m_presentStats.m_frameIdleCount      = 0;
+    m_presentStats.m_framePresentCount   = 0;
+    m_presentStats.m_frameDeferredCount  = 0;
+    m_presentStats.m_framePresentSeconds = 0.0;
+    m_presentStats.m_frameMaxStaleness   = 0;
+
+    Vec2 const       screenDimensions = Window::s_mainWindow ? QuantizeToPixel(Window::s_mainWindow->GetScreenDimensions()) : Vec2::ZERO;
+    sPixelRect const screenRect       = {0, 0, static_cast<int>(screenDimensions.x), static_cast<int>(screenDimensions.y)};
+    float const      screenArea       = static_cast<float>(std::max<int64_t>(screenRect.GetArea(), 1));
+    uint64_t const   idleInterval     = std::max(m_config.m_idlePresentIntervalFrames, 1u);
+
+    m_presentOrder.clear();
+
+    for (uint32_t denseIndex = 0; denseIndex < static_cast<uint32_t>(m_windows.size()); ++denseIndex)
+    {
+        WindowData& windowData = m_windows[denseIndex];
+        if (!windowData.m_isActive || !windowData.m_window) continue;
+        if (!windowData.m_window->m_shouldUpdatePosition) continue;
+
+        switch (windowData.m_occlusionCause)
+        {
+        case eWindowOcclusionCause::HIDDEN: ++m_visibilityStats.m_skippedPresentHiddenCount; continue;
+        case eWindowOcclusionCause::OFF_SCREEN: ++m_visibilityStats.m_skippedPresentOffScreenCount; continue;
+        case eWindowOcclusionCause::COVERED: ++m_visibilityStats.m_skippedPresentCoveredCount; continue;
+        case eWindowOcclusionCause::VIRTUALIZED: continue;
+        case eWindowOcclusionCause::NONE: break;
+        }
+
+        ++m_presentStats.m_frameCandidateCount;
+
+        bool const     hasPresented = windowData.m_lastPresentFrame != 0;
+        uint64_t const staleness    = hasPresented ? m_renderFrameIndex - windowData.m_lastPresentFrame : m_renderFrameIndex;
+        int const      movedPixels  = hasPresented ? GetPixelRectMoveDistance(windowData.m_presentedPixelRect, windowData.m_clientPixelRect) : 0;
+        bool const     isUrgent     = !hasPresented || movedPixels > 0 || windowData.m_isContentChanged;
+        float const    onScreenArea = static_cast<float>(windowData.m_clientPixelRect.GetIntersection(screenRect).GetArea());
+
+        if (!isUrgent && staleness < idleInterval)
+        {
+            ++m_presentStats.m_frameIdleCount;
+            ++m_presentStats.m_idleSkipCount;
+            continue;
+        }
+
+        if (isUrgent) ++m_presentStats.m_frameUrgentCount;
+
+        float priority = onScreenArea / screenArea + static_cast<float>(staleness) * STALENESS_WEIGHT;
+        if (movedPixels > 0) priority += MOVE_WEIGHT * (1.f + std::min(static_cast<float>(movedPixels) / MOVE_SATURATION_PIXELS, 1.f));
+        if (windowData.m_isContentChanged || !hasPresented) priority += CONTENT_WEIGHT;
+
+        windowData.m_presentPriority = priority;
+        m_presentOrder.push_back(denseIndex);
+    }
+
+    std::sort(m_presentOrder.begin(), m_presentOrder.end(), [this](uint32_t const lhs, uint32_t const rhs) {
+        float const lhsPriority = m_windows[lhs].m_presentPriority;
+        float const rhsPriority = m_windows[rhs].m_presentPriority;
+        return lhsPriority != rhsPriority ? lhsPriority > rhsPriority : lhs < rhs;
+    });
+
+    double const startSeconds = GetPresentClockSeconds();
+    double       nowSeconds   = startSeconds;
+
+    for (size_t orderIndex = 0; orderIndex < m_presentOrder.size(); ++orderIndex)
+    {
+        // 至少 present 一個視窗，避免預算設太小時所有視窗都停住
+        bool const isCountSpent = m_config.m_maxPresentsPerFrame > 0 && m_presentStats.m_framePresentCount >= m_config.m_maxPresentsPerFrame;
+        bool const isTimeSpent  = m_config.m_presentBudgetSeconds > 0.f && orderIndex > 0 && nowSeconds - startSeconds >= m_config.m_presentBudgetSeconds;
+
+        if (isCountSpent || isTimeSpent)
+        {
+            uint32_t const deferredCount = static_cast<uint32_t>(m_presentOrder.size() - orderIndex);
+            m_presentStats.m_frameDeferredCount = deferredCount;
+            m_presentStats.m_deferredCount += deferredCount;
+            ++m_presentStats.m_budgetHitCount;
+            break;
+        }
 
-    Window* window = windowIt->second.m_window.get();
+        PresentWindow(m_windows[m_presentOrder[orderIndex]], nowSeconds);
+        nowSeconds = GetPresentClockSeconds();
+    }
 
-    animData.m_animationTimer += deltaSeconds;
-    float t = animData.m_animationTimer / animData.m_animationDuration;
+    m_presentStats.m_framePresentSeconds = nowSeconds - startSeconds;
 
-    if (t >= 1.0f)
+    for (WindowData const& windowData : m_windows)
     {
-        // 動畫完成
-        t                              = 1.0f;
-        animData.m_isAnimatingSize     = false;
-        animData.m_isAnimatingPosition = false;
+        if (!windowData.m_window || windowData.m_visibility == eWindowVisibility::FULLY_OCCLUDED || windowData.m_lastPresentFrame == 0) continue;
+
+        m_presentStats.m_frameMaxStaleness = std::max(m_presentStats.m_frameMaxStaleness, m_renderFrameIndex - windowData.m_lastPresentFrame);
     }
+}
+
+void WindowSubsystem::PresentWindow(WindowData& windowData, double const nowSeconds)
+{
+    static constexpr float REFRESH_RATE_SMOOTHING = 0.2f;
 
-    // 使用 SmoothStep5 來創造平滑的動畫效果
-    float easedT = SmoothStep5(t);
+    g_theRenderer->RenderViewportToWindow(*windowData.m_window);
+    // g_theRenderer->RenderViewportToWindowDX11(*windowData.m_window);     // TODO: bug fix
+    ++m_visibilityStats.m_presentCount;
+    ++m_presentStats.m_framePresentCount;
 
-    if (animData.m_isAnimatingSize)
+    if (windowData.m_lastPresentFrame != 0 && nowSeconds > windowData.m_lastPresentSeconds)
     {
-        Vec2 currentDimensions = Interpolate(animData.m_startWindowDimensions, animData.m_targetWindowDimensions, easedT);
-        window->SetWindowDimensions(currentDimensions);
+        float const instantRate = static_cast<float>(1.0 / (nowSeconds - windowData.m_lastPresentSeconds));
+        windowData.m_refreshRate += (instantRate - windowData.m_refreshRate) * REFRESH_RATE_SMOOTHING;
     }
 
-    if (animData.m_isAnimatingPosition)
+    windowData.m_presentedPixelRect = windowData.m_clientPixelRect;
+    windowData.m_isContentChanged   = false;
+    windowData.m_lastPresentFrame   = m_renderFrameIndex;
+    windowData.m_lastPresentSeconds = nowSeconds;
+}
+
+//----------------------------------------------------------------------------------------------------
+// 移動預測：跟隨實體的視窗依速度與量到的套用延遲往前放，抵銷作業系統晚一幀以上才移動視窗
+//----------------------------------------------------------------------------------------------------
+
+bool WindowSubsystem::IsMotionPredictionEnabled() const
+{
+    return m_config.m_isMotionPredictionEnabled;
+}
+
+void WindowSubsystem::SetMotionPredictionEnabled(bool const isEnabled)
+{
+    m_config.m_isMotionPredictionEnabled = isEnabled;
+
+    // Moves issued before the switch would be matched against positions from after it
+    for (WindowData& windowData : m_windows)
     {
-        Vec2 currentPosition = Interpolate(animData.m_startWindowPosition, animData.m_targetWindowPosition, easedT);
-        window->SetWindowPosition(currentPosition);
+        windowData.m_predictionOffset = Vec2::ZERO;
+        windowData.m_hasMotionRequest = false;
+        windowData.m_issuedMoveCount  = 0;
     }
 }
 
-void WindowSubsystem::AnimateWindowPositionAndDimensions(WindowID id, Vec2 const& targetPosition, Vec2 const& targetDimensions, float duration)
+sWindowPredictionStats const& WindowSubsystem::GetPredictionStats() const
+{
+    return m_predictionStats;
+}
+
+void WindowSubsystem::ResetPredictionErrorStats()
 {
-    auto windowIt = m_windowList.find(id);
-    if (windowIt == m_windowList.end()) return;
+    m_predictionStats.m_errorSampleCount     = 0;
+    m_predictionStats.m_totalErrorPixels     = 0.0;
+    m_predictionStats.m_maxErrorPixels       = 0.f;
+    m_predictionStats.m_frameMeanErrorPixels = 0.f;
+}
 
-    Window* window = windowIt->second.m_window.get();
+void WindowSubsystem::RecordIssuedMove(WindowData& windowData, Vec2 const& clientPosition)
+{
+    // 太久沒被作業系統套用的移動直接丟掉最舊的
+    if (windowData.m_issuedMoveCount == MAX_ISSUED_WINDOW_MOVES)
+    {
+        std::copy(windowData.m_issuedMoves + 1, windowData.m_issuedMoves + MAX_ISSUED_WINDOW_MOVES, windowData.m_issuedMoves);
+        --windowData.m_issuedMoveCount;
+    }
 
-    WindowAnimationData& animData     = m_windowAnimations[id];
-    animData.m_startWindowPosition    = window->GetWindowPosition();
-    animData.m_targetWindowPosition   = targetPosition;
-    animData.m_startWindowDimensions  = window->GetWindowDimensions();
-    animData.m_targetWindowDimensions = targetDimensions;
-    animData.m_animationDuration      = duration;
-    animData.m_animationTimer         = 0.f;
-    animData.m_isAnimatingSize        = true;
-    animData.m_isAnimatingPosition    = true;
+    sIssuedWindowMove& issuedMove = windowData.m_issuedMoves[windowData.m_issuedMoveCount++];
+    issuedMove.m_clientPosition   = clientPosition;
+    issuedMove.m_frameIndex       = m_predictionFrameIndex;
 }
 
-bool WindowSubsystem::IsWindowAnimating(WindowID id) const
+// Runs right after this frame's moves were issued, so a backend that applies immediately measures zero
+// latency. Render only calls it while prediction is enabled, nothing else needs the OS rect queries. The
+// rect comes from the backend by handle, which asks the OS, because the engine Window reports a move as
+// soon as it has been requested.
+void WindowSubsystem::SampleMotionPrediction()
 {
-    auto it = m_windowAnimations.find(id);
-    return (it != m_windowAnimations.end()) && it->second.IsAnimating();
+    static constexpr float LATENCY_SMOOTHING        = 0.1f;
+    static constexpr float MATCH_DISTANCE_SQ_PIXELS = 0.25f;
+
+    double   frameErrorPixels = 0.0;
+    uint32_t frameErrorCount  = 0;
+
+    for (WindowData& windowData : m_windows)
+    {
+        if (!windowData.m_hasMotionRequest) continue;
+        windowData.m_hasMotionRequest = false;
+
+        if (windowData.m_isVirtual || !windowData.m_isActive) continue;
+
+        Vec2 const observedPosition = m_backend->GetClientRect(windowData.m_nativeHandle, nullptr).m_mins;
+
+        // The newest issued move the OS has caught up with gives one latency sample, it and everything older are done
+        for (int moveIndex = windowData.m_issuedMoveCount - 1; moveIndex >= 0; --moveIndex)
+        {
+            sIssuedWindowMove const& issuedMove = windowData.m_issuedMoves[moveIndex];
+            if (GetDistanceSquared2D(issuedMove.m_clientPosition, observedPosition) > MATCH_DISTANCE_SQ_PIXELS) continue;
+
+            float const latencyFrames = static_cast<float>(m_predictionFrameIndex - issuedMove.m_frameIndex);
+            m_predictionStats.m_applyLatencyFrames += (latencyFrames - m_predictionStats.m_applyLatencyFrames) * LATENCY_SMOOTHING;
+            ++m_predictionStats.m_latencySampleCount;
+
+            std::copy(windowData.m_issuedMoves + moveIndex + 1, windowData.m_issuedMoves + windowData.m_issuedMoveCount, windowData.m_issuedMoves);
+            windowData.m_issuedMoveCount = static_cast<uint8_t>(windowData.m_issuedMoveCount - (moveIndex + 1));
+            break;
+        }
+
+        float const errorPixels = GetDistance2D(observedPosition, windowData.m_unpredictedClientPosition);
+        m_predictionStats.m_totalErrorPixels += errorPixels;
+        m_predictionStats.m_maxErrorPixels = std::max(m_predictionStats.m_maxErrorPixels, errorPixels);
+        ++m_predictionStats.m_errorSampleCount;
+
+        frameErrorPixels += errorPixels;
+        ++frameErrorCount;
+    }
+
+    m_predictionStats.m_frameMeanErrorPixels = frameErrorCount > 0 ? static_cast<float>(frameErrorPixels / frameErrorCount) : 0.f;
 }
@@ -6,41 +6,386 @@
 #pragma once
 #include <memory>
 #include <unordered_map>
-#include <unordered_set>
 #include <vector>
 
+#include "Engine/Math/IntVec2.hpp"
 #include "Engine/Platform/Window.hpp"
-#include "Game/Gameplay/Entity.hpp"
+#include "Game/Framework/GameCommon.hpp"
+#include "Game/Subsystem/Tween/TweenEngine.hpp"
+#include "Game/Subsystem/Window/IWindowBackend.hpp"
+#include "Game/Subsystem/Window/PixelRegion.hpp"
+#include "Game/Subsystem/Window/ThreadedWindowBackend.hpp"
+#include "Game/Subsystem/Window/WindowSpatialIndex.hpp"
 
 //----------------------------------------------------------------------------------------------------
-struct WindowAnimationData
+// Window properties driven by the subsystem's TweenEngine, keyed by WindowID.
+enum class eWindowTweenChannel : uint8_t
 {
-    bool m_isAnimatingSize     = false;
-    bool m_isAnimatingPosition = false;
+    POSITION,
+    DIMENSIONS
+};
+
+//----------------------------------------------------------------------------------------------------
+// Window properties that gameplay requests every frame and the OS only needs to hear about on change.
+enum class eWindowStateField : uint8_t
+{
+    VISIBILITY,
+    POSITION,
+    DIMENSIONS,
+    TITLE,
+    COUNT
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sWindowState
+{
+    Vec2   m_clientPosition   = Vec2::ZERO;     // Quantised to whole pixels
+    Vec2   m_clientDimensions = Vec2::ZERO;     // Quantised to whole pixels
+    String m_title;
+    bool   m_isVisible = true;
+};
+
+//----------------------------------------------------------------------------------------------------
+// Result of the per-frame visibility pass over child client rects and their z-order.
+enum class eWindowVisibility : uint8_t
+{
+    FULLY_OCCLUDED,         // Hidden, off-screen, virtual or covered by child windows above it, present is skipped
+    PARTIALLY_VISIBLE,
+    FULLY_VISIBLE
+};
+
+//----------------------------------------------------------------------------------------------------
+enum class eWindowOcclusionCause : uint8_t
+{
+    NONE,
+    HIDDEN,
+    OFF_SCREEN,
+    COVERED,
+    VIRTUALIZED             // Evicted by the live window budget, there is nothing to present
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sWindowRectCoalesceStats
+{
+    // Totals since start up
+    uint64_t m_requestCount        = 0;   // RequestWindowRectDelta calls, each used to start its own animation
+    uint64_t m_tweenStartCount     = 0;   // Windows whose merged request started a new tween
+    uint64_t m_tweenRetargetCount  = 0;   // Windows whose merged request redirected the in-flight tween
+    uint64_t m_resizeAppliedCount  = 0;   // Animated dimension changes that reached the Window
+    uint64_t m_resizeSkippedCount  = 0;   // Animated dimension changes dropped for staying on the same pixel size
+
+    // The same counters over the last full second
+    uint64_t m_requestsPerSecond       = 0;
+    uint64_t m_tweenStartsPerSecond    = 0;
+    uint64_t m_tweenRetargetsPerSecond = 0;
+    uint64_t m_resizesAppliedPerSecond = 0;
+    uint64_t m_resizesSkippedPerSecond = 0;
+
+    uint64_t GetAnimationsSavedPerSecond() const { return m_requestsPerSecond - m_tweenStartsPerSecond; }
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sWindowReconcileStats
+{
+    static constexpr int FIELD_COUNT = static_cast<int>(eWindowStateField::COUNT);
+
+    uint32_t m_frameRequested[FIELD_COUNT] = {};    // Request* calls since BeginFrame
+    uint32_t m_frameIssued[FIELD_COUNT]    = {};    // OS calls actually issued since BeginFrame
+    uint64_t m_totalRequested[FIELD_COUNT] = {};
+    uint64_t m_totalIssued[FIELD_COUNT]    = {};
+
+    uint32_t GetFrameSaved(eWindowStateField field) const { return m_frameRequested[(int)field] - m_frameIssued[(int)field]; }
+    uint64_t GetTotalSaved(eWindowStateField field) const { return m_totalRequested[(int)field] - m_totalIssued[(int)field]; }
+};
+
+//----------------------------------------------------------------------------------------------------
+// Entities sharing a window. Almost always one or two, so the first few live inline and the list only
+// spills to the heap beyond that. Either way the owners stay contiguous for AsSpan().
+struct sWindowOwnerList
+{
+    static constexpr uint32_t INLINE_CAPACITY = 4;
 
-    Vec2 m_targetWindowDimensions = Vec2::ZERO;
-    Vec2 m_startWindowDimensions  = Vec2::ZERO;
-    Vec2 m_targetWindowPosition   = Vec2::ZERO;
-    Vec2 m_startWindowPosition    = Vec2::ZERO;
+    bool                  Add(EntityID entityID);
+    bool                  Remove(EntityID entityID);
+    bool                  Contains(EntityID entityID) const;
+    uint32_t              GetCount() const { return m_count; }
+    bool                  IsEmpty() const { return m_count == 0; }
+    sConstSpan<EntityID>  AsSpan() const { return {GetData(), m_count}; }
+    EntityID const*       begin() const { return GetData(); }
+    EntityID const*       end() const { return GetData() + m_count; }
 
-    float m_animationDuration = 0.5f;
-    float m_animationTimer    = 0.0f;
+private:
+    EntityID const* GetData() const { return m_overflow.empty() ? m_inline : m_overflow.data(); }
+    EntityID*       GetData() { return m_overflow.empty() ? m_inline : m_overflow.data(); }
+
+    EntityID              m_inline[INLINE_CAPACITY] = {};
+    std::vector<EntityID> m_overflow;   // Holds every owner once the inline slots are exceeded
+    uint32_t              m_count = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// An entity's cached link to its child window. Filled once by BindWindow(), so per-frame access needs
+// neither FindWindowIDByEntityID nor GetWindowData. WindowSubsystem calls Invalidate() on every binding of
+// a window it destroys.
+struct sWindowBinding
+{
+    WindowID m_windowID = 0;
+    Window*  m_window   = nullptr;      // nullptr when the backend is not native or the window is virtual
+
+    bool IsBound() const { return m_windowID != 0; }
+    void Invalidate()
+    {
+        m_windowID = 0;
+        m_window   = nullptr;
+    }
+};
 
-    bool IsAnimating() const { return m_isAnimatingSize || m_isAnimatingPosition; }
+//----------------------------------------------------------------------------------------------------
+// Geometry of one window as captured by WindowSubsystem::Update, in client coordinates (y-up). Gameplay
+// reads this instead of querying the Window, so every reader sees the same values within a frame.
+struct sWindowGeometry
+{
+    AABB2    m_windowRect;         // Including the frame
+    AABB2    m_clientRect;
+    bool     m_isVisible = false;  // Active and shown
+    uint32_t m_revision  = 0;      // Bumped whenever a capture changes any of the above, so readers can skip unchanged windows
+
+    Vec2 GetWindowPosition() const { return m_windowRect.m_mins; }
+    Vec2 GetWindowDimensions() const { return m_windowRect.m_maxs - m_windowRect.m_mins; }
+    Vec2 GetClientPosition() const { return m_clientRect.m_mins; }
+    Vec2 GetClientDimensions() const { return m_clientRect.m_maxs - m_clientRect.m_mins; }
+};
+
+//----------------------------------------------------------------------------------------------------
+// A position pushed to the OS, kept until GetClientRect reports it so the apply latency can be measured.
+struct sIssuedWindowMove
+{
+    Vec2     m_clientPosition = Vec2::ZERO;
+    uint64_t m_frameIndex     = 0;
 };
 
+static constexpr uint8_t MAX_ISSUED_WINDOW_MOVES = 8;
+
 //----------------------------------------------------------------------------------------------------
 struct WindowData
 {
-    std::unique_ptr<Window>      m_window;
-    std::unordered_set<EntityID> m_owners;
-    String                       m_name;
-    bool                         m_isActive = true;
+    std::unique_ptr<Window> m_window;          // nullptr when the backend is not native or the window is virtual
+    NativeWindowHandle      m_nativeHandle = nullptr;
+    sWindowOwnerList        m_owners;
+    String                  m_name;
+    bool                    m_isActive = true;
+
+    std::vector<sWindowBinding*> m_bindings;    // Invalidated when this window is destroyed
+
+    // Relative rect requests made this frame, merged into a single tween target in CommitWindowRectDeltas()
+    Vec2        m_pendingPositionDelta   = Vec2::ZERO;
+    Vec2        m_pendingDimensionsDelta = Vec2::ZERO;
+    float       m_pendingDurationSeconds = 0.f;
+    eEasingType m_pendingEasingType      = eEasingType::SMOOTH_STOP_2;
+    bool        m_hasPendingRectDelta    = false;
+
+    // Swap chain resizes held back during dimension animations, see UpdateSwapChainSize()
+    IntVec2  m_swapChainSize                = IntVec2::ZERO;    // Client size the swap chain was last allocated for
+    bool     m_hasPendingSwapChainResize    = false;
+    uint32_t m_swapChainResizeCount         = 0;
+    uint32_t m_swapChainDeferredResizeCount = 0;                // Dimension changes absorbed without reallocating
+
+    // Client rect last posted to the window thread, see PostClientRect(). Zero dimensions mean nothing posted yet
+    Vec2 m_postedClientPosition   = Vec2::ZERO;
+    Vec2 m_postedClientDimensions = Vec2::ZERO;
+
+    // Reconciler: gameplay writes m_desiredState, CommitWindowStates() pushes the difference to the OS.
+    sWindowState m_desiredState;
+    sWindowState m_appliedState;
+    uint8_t      m_dirtyFields   = 0;   // Bit per eWindowStateField requested since the last commit
+    uint8_t      m_appliedFields = 0;   // Bit per eWindowStateField whose m_appliedState matches the OS
+
+    IntVec2 m_poolBucketSize = IntVec2::ZERO;    // Client size the window was created with
+
+    sWindowGeometry m_geometry;     // Written only by CaptureWindowGeometry()
+
+    // Live window budget, see EnforceWindowBudget(). A virtual window has no OS window or swap chain, gameplay
+    // keeps writing m_desiredState and it is all pushed to the OS again when the window is rematerialised.
+    bool     m_isVirtual         = false;
+    bool     m_isPinned          = false;   // Never virtualised
+    uint64_t m_lastRelevantFrame = 0;       // Last budget pass that found the window shown and on screen
+
+    // Written by UpdateWindowVisibility() every Render
+    sPixelRect            m_clientPixelRect;
+    uint32_t              m_zOrder         = UINT32_MAX;     // 0 is topmost
+    eWindowVisibility     m_visibility     = eWindowVisibility::FULLY_VISIBLE;
+    eWindowOcclusionCause m_occlusionCause = eWindowOcclusionCause::NONE;
+
+    // Present scheduling, see PresentWindows()
+    sPixelRect m_presentedPixelRect;                 // Client rect at the last present
+    bool       m_isContentChanged   = true;         // Something under the client rect moved since the last present
+    uint64_t   m_lastPresentFrame   = 0;            // Render index, 0 until the first present
+    double     m_lastPresentSeconds = 0.0;
+    float      m_refreshRate        = 0.f;          // Presents per second, smoothed
+    float      m_presentPriority    = 0.f;
+
+    // Motion prediction, see RequestClientPosition(windowID, clientPosition, velocity)
+    Vec2              m_unpredictedClientPosition = Vec2::ZERO;     // Where the entity itself puts the window this frame
+    Vec2              m_predictionOffset          = Vec2::ZERO;     // Smoothed lead added on top of it
+    bool              m_hasMotionRequest          = false;          // Cleared every Render by SampleMotionPrediction()
+    sIssuedWindowMove m_issuedMoves[MAX_ISSUED_WINDOW_MOVES];       // Oldest first
+    uint8_t           m_issuedMoveCount = 0;
+};
+
+//----------------------------------------------------------------------------------------------------
+// A hidden, fully created child window (OS window, DC, swap chain) waiting to be handed out again.
+struct sPooledWindow
+{
+    std::unique_ptr<Window> m_window;
+    NativeWindowHandle      m_nativeHandle = nullptr;
+    String                  m_title;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sWindowPoolStats
+{
+    uint32_t m_hitCount     = 0;    // CreateChildWindow served from the pool
+    uint32_t m_missCount    = 0;    // CreateChildWindow had to create a new OS window
+    uint32_t m_returnCount  = 0;    // DestroyWindow parked the window in the pool
+    uint32_t m_discardCount = 0;    // DestroyWindow really destroyed it (bucket full or size drifted)
+    uint32_t m_warmUpCount  = 0;    // Windows pre-created by WarmUpWindowPool
+    size_t   m_pooledCount  = 0;    // Hidden windows currently parked
+};
+
+//----------------------------------------------------------------------------------------------------
+// WindowID = (generation << WINDOW_ID_INDEX_BITS) | slot index. The generation starts at 1 and is bumped
+// every time the slot is freed, so a stale ID never resolves to whichever window reuses the slot and 0
+// stays the invalid ID.
+static constexpr uint32_t WINDOW_ID_INDEX_BITS      = 20;
+static constexpr uint32_t WINDOW_ID_INDEX_MASK      = (1u << WINDOW_ID_INDEX_BITS) - 1u;
+static constexpr uint32_t WINDOW_ID_GENERATION_MASK = (1u << (32 - WINDOW_ID_INDEX_BITS)) - 1u;
+static constexpr uint32_t INVALID_WINDOW_DENSE_INDEX = UINT32_MAX;
+
+struct sWindowSlot
+{
+    uint32_t m_denseIndex = INVALID_WINDOW_DENSE_INDEX;   // Index into m_windows, or invalid while the slot is free
+    uint32_t m_generation = 1;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sSwapChainResizeStats
+{
+    uint64_t m_resizeCount         = 0;     // ResizeWindowSwapChain calls
+    uint64_t m_driftResizeCount    = 0;     // ...of which a running dimension animation drifted past the slack
+    uint64_t m_deferredResizeCount = 0;     // Dimension changes held back while a dimension animation runs
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sWindowReadbackStats
+{
+    uint64_t m_readbackCount        = 0;    // Full-screen ReadStagingTextureToPixelData calls
+    uint64_t m_skippedReadbackCount = 0;    // Frames with no child window on screen, readback not issued
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sWindowVisibilityStats
+{
+    uint32_t m_frameFullyVisibleCount     = 0;
+    uint32_t m_framePartiallyVisibleCount = 0;
+    uint32_t m_frameOccludedCount         = 0;
+
+    // Totals since start up
+    uint64_t m_presentCount                 = 0;
+    uint64_t m_skippedPresentHiddenCount    = 0;
+    uint64_t m_skippedPresentOffScreenCount = 0;
+    uint64_t m_skippedPresentCoveredCount   = 0;
+
+    uint64_t GetSkippedPresentCount() const { return m_skippedPresentHiddenCount + m_skippedPresentOffScreenCount + m_skippedPresentCoveredCount; }
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sWindowPresentInfo
+{
+    float    m_refreshRate         = 0.f;   // Presents per second, smoothed
+    uint64_t m_framesSincePresent  = 0;     // Render calls since the window was last presented
+    double   m_secondsSincePresent = 0.0;
+    bool     m_hasPresented        = false;
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sWindowPresentStats
+{
+    uint32_t m_frameCandidateCount = 0;     // Visible windows this Render
+    uint32_t m_frameUrgentCount    = 0;     // ...that moved, changed content or were never presented
+    uint32_t m_frameIdleCount      = 0;     // ...that were neither urgent nor due for their idle refresh
+    uint32_t m_framePresentCount   = 0;
+    uint32_t m_frameDeferredCount  = 0;     // Urgent or due windows pushed to a later frame by the budget
+    double   m_framePresentSeconds = 0.0;
+    uint64_t m_frameMaxStaleness   = 0;     // Frames since present of the stalest visible window, after presenting
+
+    // Totals since start up
+    uint64_t m_deferredCount   = 0;
+    uint64_t m_idleSkipCount   = 0;
+    uint64_t m_budgetHitCount  = 0;         // Renders that ran out of present budget
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sWindowPredictionStats
+{
+    float    m_applyLatencyFrames = 0.f;    // Smoothed frames from issuing a move to the OS reporting it
+    uint64_t m_latencySampleCount = 0;
+
+    // Distance between where a following window really is at Render and where its entity is, one sample per
+    // window per Render while prediction is enabled. Nothing is sampled with prediction off.
+    uint64_t m_errorSampleCount     = 0;
+    double   m_totalErrorPixels     = 0.0;
+    float    m_maxErrorPixels       = 0.f;
+    float    m_frameMeanErrorPixels = 0.f;
+
+    double GetMeanErrorPixels() const { return m_errorSampleCount > 0 ? m_totalErrorPixels / static_cast<double>(m_errorSampleCount) : 0.0; }
+};
+
+//----------------------------------------------------------------------------------------------------
+struct sWindowBudgetStats
+{
+    uint32_t m_maxLiveWindows          = 0;     // 0 is unlimited
+    uint32_t m_liveCount               = 0;     // Windows holding an OS window and swap chain
+    uint32_t m_virtualCount            = 0;
+    uint32_t m_peakLiveCount           = 0;
+    uint32_t m_frameEvictionCount      = 0;     // Since BeginFrame
+    uint32_t m_frameRematerializeCount = 0;
+
+    // Totals since start up
+    uint64_t m_evictionCount              = 0;
+    uint64_t m_rematerializeCount         = 0;
+    uint64_t m_onDemandRematerializeCount = 0;  // ...of which forced by an animation or rect delta on a virtual window
+    uint64_t m_overBudgetFrameCount       = 0;  // Budget passes where pinned and animating windows alone exceeded it
+};
+
+//----------------------------------------------------------------------------------------------------
+// One window's rank in the budget pass, most relevant first.
+struct sWindowBudgetCandidate
+{
+    uint32_t m_denseIndex        = 0;
+    bool     m_isProtected       = false;   // Pinned or animating
+    uint64_t m_lastRelevantFrame = 0;
+    float    m_rankDistanceSq    = 0.f;     // To the budget focus, scaled down for live windows
 };
 
+//----------------------------------------------------------------------------------------------------
 struct sWindowSubsystemConfig
 {
-    wchar_t const* m_iconFilePath = nullptr;
+    wchar_t const*  m_iconFilePath               = nullptr;
+    IWindowBackend* m_backend                    = nullptr;     // Not owned. nullptr creates and owns a Win32WindowBackend
+    size_t          m_maxPooledWindowsPerBucket  = 16;
+    int             m_swapChainResizeSlack       = 32;          // Pixels an animating window may drift from its swap chain size before it reallocates
+    float           m_spatialIndexCellSize       = 256.f;
+    bool            m_useWindowThread            = false;       // Run m_backend on a dedicated thread behind a command queue
+    uint32_t        m_windowCommandQueueCapacity = 1024;
+    uint32_t        m_maxLiveWindows             = 0;           // Live OS windows before the least relevant go virtual, 0 is unlimited
+    float           m_windowBudgetHysteresis     = 0.8f;        // Live windows rank as if this much closer to the focus, so the cut-off does not thrash
+    uint32_t        m_maxPresentsPerFrame        = 0;           // 0 is unlimited
+    float           m_presentBudgetSeconds       = 0.f;         // Time spent presenting per Render, 0 is unlimited
+    uint32_t        m_idlePresentIntervalFrames  = 1;           // Windows that neither moved nor changed are refreshed at most this often
+    bool            m_isMotionPredictionEnabled  = false;       // Lead following windows by velocity times the measured apply latency
+    float           m_initialApplyLatencyFrames  = 1.f;         // Latency assumed until the first measurement
+    float           m_maxPredictionLeadSeconds   = 0.1f;
+    float           m_predictionSmoothingSeconds = 0.08f;       // Time constant for easing the lead after the entity turns or stops
 };
 
 //----------------------------------------------------------------------------------------------------
@@ -51,6 +396,7 @@ public:
     void     StartUp();
     void     BeginFrame();
     void     Update();
+    void     UpdateWindows(float deltaSeconds);     // Update() on an explicit time step, without reading the game's state or clock
     void     Render();
     void     EndFrame();
     void     ShutDown();
@@ -63,19 +409,36 @@ public:
     void     DestroyWindow(WindowID windowID);
     void     DestroyAllWindows();
 
+    // Cached entity -> window bindings
+    bool BindWindow(WindowID windowID, sWindowBinding& binding);
+    void UnbindWindow(sWindowBinding& binding);
+
     // Show and Hide window
     void ShowWindowByWindowID(WindowID windowID);
     void HideWindowByWindowID(WindowID windowID);
 
+    // Deferred window state, diffed against the applied state once per frame in CommitWindowStates()
+    void                         RequestWindowVisibility(WindowID windowID, bool isVisible);
+    void                         RequestClientPosition(WindowID windowID, Vec2 const& clientPosition);
+    void                         RequestClientPosition(WindowID windowID, Vec2 const& clientPosition, Vec2 const& velocity);
+    void                         RequestClientDimensions(WindowID windowID, Vec2 const& clientDimensions);
+    void                         RequestWindowTitle(WindowID windowID, String const& title);
+    void                         CommitWindowStates();
+    sWindowReconcileStats const& GetReconcileStats() const;
+
     // 查詢功能
     Window*               GetWindow(WindowID windowID);
     WindowData*           GetWindowData(WindowID windowID);
     WindowID              FindWindowIDByEntityID(EntityID entityID);
-    std::vector<EntityID> GetWindowOwners(WindowID windowID);
-    std::vector<WindowID> GetActorWindows(EntityID entityID);
-    std::vector<WindowID> GetAllWindowIDs();
-    bool                  IsActorInWindow(WindowID windowID, EntityID entityID);
-    bool                  WindowExists(WindowID windowID);
+    WindowData const*     GetWindowData(WindowID windowID) const;
+    sConstSpan<EntityID>  GetWindowOwners(WindowID windowID) const;
+    sConstSpan<WindowID>  GetActorWindows(EntityID entityID) const;
+    sConstSpan<WindowID>  GetAllWindowIDs() const;
+    bool                  IsActorInWindow(WindowID windowID, EntityID entityID) const;
+    bool                  WindowExists(WindowID windowID) const;
+
+    // Per-frame geometry, captured once per Update after windows have moved. nullptr for unknown IDs.
+    sWindowGeometry const* GetWindowGeometry(WindowID windowID) const;
 
     // 視窗操作
     void   UpdateWindowPosition(WindowID windowID);
@@ -88,23 +451,140 @@ public:
     size_t GetWindowCount() const;
     size_t GetActiveWindowCount() const;
 
+    IWindowBackend* GetBackend() const;
+
+    // Dedicated window thread, see ThreadedWindowBackend
+    bool               IsUsingWindowThread() const;
+    void               FlushWindowThread();
+    sWindowThreadStats GetWindowThreadStats() const;
+
+    // Window pool, bucketed by client size
+    void                    WarmUpWindowPool(int width, int height, int count);
+    void                    ClearWindowPool();
+    sWindowPoolStats const& GetWindowPoolStats() const;
+
     // Animations
-    void AnimateWindowDimensions(WindowID id, Vec2 const& targetDimensions, float duration = 0.5f);
-    void AnimateWindowPosition(WindowID id, Vec2 const& targetPosition, float duration = 0.5f);
-    void AnimateWindowPositionAndDimensions(WindowID id, Vec2 const& targetPosition, Vec2 const& targetDimensions, float duration = 0.5f);
-    bool IsWindowAnimating(WindowID id) const;
+    void               AnimateWindowDimensions(WindowID id, Vec2 const& targetDimensions, float duration = 0.5f, eEasingType easingType = eEasingType::SMOOTH_STEP_5);
+    void               AnimateWindowPosition(WindowID id, Vec2 const& targetPosition, float duration = 0.5f, eEasingType easingType = eEasingType::SMOOTH_STEP_5);
+    void               AnimateWindowPositionAndDimensions(WindowID id, Vec2 const& targetPosition, Vec2 const& targetDimensions, float duration = 0.5f, eEasingType easingType = eEasingType::SMOOTH_STEP_5);
+    bool               IsWindowAnimating(WindowID id) const;
+    sTweenStats const& GetWindowTweenStats() const;
+
+    // Relative, additive rect changes. Every request made for a window within a frame is summed and applied
+    // on top of the target it is already animating toward, retargeting the running animation if there is one.
+    // The easing only applies when a new animation starts, a retargeted one keeps its own.
+    void                            RequestWindowRectDelta(WindowID id, Vec2 const& positionDelta, Vec2 const& dimensionsDelta, float duration = 0.1f, eEasingType easingType = eEasingType::SMOOTH_STOP_2);
+    sWindowRectCoalesceStats const& GetRectCoalesceStats() const;
+
+    // Swap chain resizes
+    uint32_t                     GetSwapChainResizeCount(WindowID windowID) const;
+    sSwapChainResizeStats const& GetSwapChainResizeStats() const;
+
+    // Screen readback
+    sWindowReadbackStats const& GetReadbackStats() const;
+
+    // Occlusion culling, classified once per Render before presenting
+    eWindowVisibility             GetWindowVisibility(WindowID windowID) const;
+    sWindowVisibilityStats const& GetVisibilityStats() const;
+
+    // Present scheduling. Windows that moved or whose content changed are presented first, largest on-screen
+    // area first, the rest are refreshed round-robin every m_idlePresentIntervalFrames within the budget.
+    void                       MarkWindowContentChanged(WindowID windowID);
+    void                       MarkWindowContentChangedInDisc(Vec2 const& center, float radius);
+    sWindowPresentInfo         GetWindowPresentInfo(WindowID windowID) const;
+    sWindowPresentStats const& GetPresentStats() const;
+
+    // Motion prediction for windows that follow an entity, see RequestClientPosition with a velocity
+    bool                          IsMotionPredictionEnabled() const;
+    void                          SetMotionPredictionEnabled(bool isEnabled);
+    sWindowPredictionStats const& GetPredictionStats() const;
+    void                          ResetPredictionErrorStats();
+
+    // Spatial queries over the client rects of active, visible child windows (client coordinates, y-up).
+    // Rects are refreshed once per Update, touching a window's edge counts as a hit.
+    void                      QueryWindowsAtPoint(Vec2 const& point, std::vector<WindowID>& out_windowIDs) const;
+    void                      QueryWindowsInDisc(Vec2 const& center, float radius, std::vector<WindowID>& out_windowIDs) const;
+    void                      QueryWindowsInRect(AABB2 const& rect, std::vector<WindowID>& out_windowIDs) const;
+    WindowSpatialIndex const& GetWindowSpatialIndex() const;
+
+    // Live window budget. Over m_maxLiveWindows, the windows that have gone longest without being shown on
+    // screen, then the furthest from the focus, become virtual until they are relevant again.
+    void                      SetWindowPinned(WindowID windowID, bool isPinned);
+    void                      SetWindowBudgetFocus(Vec2 const& focusPosition);
+    bool                      IsWindowVirtual(WindowID windowID) const;
+    sWindowBudgetStats const& GetWindowBudgetStats() const;
 
 private:
     sWindowSubsystemConfig                            m_config;
-    std::unordered_map<WindowID, WindowData>          m_windowList;// 主要資料結構：WindowID -> WindowData
+    IWindowBackend*                                   m_backend = nullptr;
+    std::unique_ptr<IWindowBackend>                   m_ownedBackend;
+    std::unique_ptr<ThreadedWindowBackend>            m_threadedBackend;  // Wraps the backend above, destroyed first
+    std::vector<WindowData>                           m_windows;          // 主要資料結構：連續存放，Update/Render 直接走訪
+    std::vector<WindowID>                             m_denseWindowIDs;   // 與 m_windows 平行：m_windows[i] 的 WindowID
+    std::vector<sWindowSlot>                          m_windowSlots;      // WindowID 的 slot index -> m_windows 索引與世代
+    std::vector<uint32_t>                             m_freeWindowSlots;
     std::unordered_map<EntityID, WindowID>            m_actorToWindow;// 快速查找：ActorID -> WindowID (一個actor只能在一個視窗)
-    std::unordered_map<WindowID, WindowAnimationData> m_windowAnimations;
-    WindowID                                          m_nextWindowID = 1; // 從1開始，0保留為無效ID
+    TweenEngine                                       m_windowTweens;     // 視窗位置與尺寸動畫
+    sWindowRectCoalesceStats                          m_rectCoalesceStats;
+    sWindowRectCoalesceStats                          m_rectCoalesceStatsAtLastSecond;
+    float                                             m_rectCoalesceSecondTimer = 0.f;
+    sSwapChainResizeStats                             m_swapChainResizeStats;
+    sWindowReadbackStats                              m_readbackStats;
+    std::vector<NativeWindowHandle>                   m_zOrderHandles;        // Scratch for the visibility pass
+    std::vector<uint32_t>                             m_zOrders;
+    std::vector<uint32_t>                             m_zSortedDenseIndices;
+    std::vector<sPixelRect>                           m_coveringRects;
+    std::vector<sPixelRect>                           m_coveredRegion;
+    sWindowVisibilityStats                            m_visibilityStats;
+    std::vector<uint32_t>                             m_presentOrder;         // Scratch for PresentWindows()
+    std::vector<WindowID>                             m_contentChangedScratch;
+    uint64_t                                          m_renderFrameIndex = 0;
+    sWindowPresentStats                               m_presentStats;
+    uint64_t                                          m_predictionFrameIndex = 0;   // Bumped every Update
+    float                                             m_frameDeltaSeconds = 0.f;
+    sWindowPredictionStats                            m_predictionStats;
+    WindowSpatialIndex                                m_windowSpatialIndex;
+    std::vector<sWindowBudgetCandidate>               m_budgetCandidates;     // Scratch for EnforceWindowBudget()
+    Vec2                                              m_budgetFocus = Vec2::ZERO;
+    uint64_t                                          m_budgetFrameIndex = 0;
+    sWindowBudgetStats                                m_budgetStats;
+    sWindowReconcileStats                             m_reconcileStats;
+    std::unordered_map<uint64_t, std::vector<sPooledWindow>> m_windowPool;    // (width, height) bucket -> hidden windows
+    sWindowPoolStats                                  m_windowPoolStats;
 
-    HWND   CreateOSWindow(String const& title, int x, int y, int width, int height);
+    bool   CreatePooledWindow(String const& title, int x, int y, int width, int height, sPooledWindow& out_pooledWindow);
+    bool   AcquirePooledWindow(int width, int height, sPooledWindow& out_pooledWindow);
+    bool   ReleaseWindowToPool(WindowData& windowData);
     void   SetupTransparentMainWindow();
-    String GenerateDefaultWindowName(std::vector<EntityID> const& owners) const;
+    void   InvalidateWindowBindings(WindowData& windowData);
+    void   RefreshWindowBindings(WindowData& windowData);
+    String GenerateDefaultWindowName(sConstSpan<EntityID> const& owners) const;
+
+    WindowID AllocateWindowSlot();
+    void     FreeWindowSlot(WindowID windowID);
+    uint32_t FindDenseIndex(WindowID windowID) const;
+    AABB2    QueryClientRect(WindowData const& windowData);
+    void     CaptureWindowGeometry();
+    void     CaptureWindowGeometry(WindowData& windowData);
+
+    void CommitSingleWindowState(WindowData& windowData);
+    void InvalidateAppliedState(WindowData& windowData, eWindowStateField field);
 
     void UpdateWindowAnimations(float deltaSeconds);
-    void UpdateSingleWindowAnimation(WindowID id, WindowAnimationData& animData, float deltaSeconds);
+    void CommitWindowRectDeltas();
+    void UpdateRectCoalesceRates(float deltaSeconds);
+    void UpdateSwapChainSize(WindowID windowID, WindowData& windowData);
+    void PostClientRect(WindowData& windowData);
+    void UpdateWindowVisibility();
+    void ClassifyOcclusion(WindowData& windowData, eWindowOcclusionCause cause);
+    void PresentWindows();
+    void PresentWindow(WindowData& windowData, double nowSeconds);
+    void RecordIssuedMove(WindowData& windowData, Vec2 const& clientPosition);
+    void SampleMotionPrediction();
+    void ApplyWindowTweenValue(WindowID windowID, eWindowTweenChannel channel, Vec2 const& value);
+
+    void EnforceWindowBudget();
+    void VirtualizeWindow(WindowID windowID, WindowData& windowData);
+    bool MaterializeWindow(WindowID windowID, WindowData& windowData);
+    void MaterializeWindowOnDemand(WindowID windowID);
 };